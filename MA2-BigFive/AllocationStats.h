@@ -0,0 +1,312 @@
+/*
+ * AllocationStats.h - Opt-in allocation and lifetime counters
+ *
+ *  LinkedList (nodes) and the Array family (item buffers) count what they
+ *  allocate and free, the bytes they hold and how often they are copied or
+ *  moved.  Containers update their counters with
+ *  CONTAINER_STATS_RECORD(statement).  Unless the program is built with
+ *  -DCONTAINER_STATS (make ... STATS=1) the macro expands to nothing, so
+ *  the counters are never touched and getStats() reports zeros.  The
+ *  counters themselves are always there: a container's layout must not
+ *  depend on the flag, or translation units built with and without it
+ *  would disagree on it.
+ *
+ *  When counting is on, each container keeps an AllocationStats of its own
+ *  (plain integers, as containers are not shared between threads) and every
+ *  update also goes to the calling thread's share of the process-wide
+ *  counters, read with AllocationStats::global().  Either way an update is
+ *  a handful of adds with no locked instructions, so it can stay on in
+ *  production builds.
+ *
+ *  Bytes are what the container asked for: sizeof(ListNode<T>) per node,
+ *  capacity * sizeof(T) per buffer.  overhead_bytes is the part of that
+ *  which is not items, i.e. each node's vtable pointer, _next and padding.
+ *  Memory that changes owner with a move is carried over by takeLive, so
+ *  live and peak figures follow the memory, while allocations and frees
+ *  stay with whichever container made them.
+ *
+ */
+
+#ifndef ALLOCATION_STATS_H
+#define ALLOCATION_STATS_H
+
+#include <algorithm>
+#include <atomic>
+#include <initializer_list>
+#include <mutex>
+#include <vector>
+
+using namespace std;
+
+struct AllocationStats
+{
+    long long allocations = 0;      // Nodes or item buffers allocated
+    long long frees = 0;            // ... and given back
+    long long live_nodes = 0;
+    long long peak_nodes = 0;
+    long long live_bytes = 0;       // Including overhead_bytes
+    long long peak_bytes = 0;
+    long long overhead_bytes = 0;   // Live bytes that don't hold items
+    long long copies = 0;           // Copy constructions and assignments
+    long long moves = 0;            // Move constructions and assignments
+
+    void allocated(long long bytes, long long nodes, long long overhead);
+    void freed(long long bytes, long long nodes, long long overhead);
+    void copied();
+    void moved();
+
+    // Takes over the live memory other was holding, which now belongs to us
+    void takeLive(AllocationStats &other);
+
+    // Counters summed over every container in the process
+    static AllocationStats global();
+
+    // Zeroes the global counters.  Containers alive at the time will later
+    //  free memory the counters never saw, so live figures can go negative.
+    static void resetGlobal();
+};
+
+// Process-wide counters behind AllocationStats::global().  Each thread
+//  counts into a shard of its own that no other thread writes, so an update
+//  is a plain load and store with no locked instruction; the counters are
+//  relaxed atomics only so that readers see whole values.  Reading sums the
+//  shards of running threads and what exited threads left behind.  The
+//  global peaks are the sums of each thread's peak: exact while one thread
+//  does the allocating, an upper bound otherwise.
+class GlobalAllocationStats
+{
+    struct Shard
+    {
+        atomic<long long> allocations;
+        atomic<long long> frees;
+        atomic<long long> live_nodes;
+        atomic<long long> peak_nodes;
+        atomic<long long> live_bytes;
+        atomic<long long> peak_bytes;
+        atomic<long long> overhead_bytes;
+        atomic<long long> copies;
+        atomic<long long> moves;
+
+        Shard()
+        {
+            clear();
+        }
+
+        // Only the owning thread calls this, so load + store can't lose counts
+        static long long add(atomic<long long> &counter, long long amount)
+        {
+            long long value = counter.load(memory_order_relaxed) + amount;
+            counter.store(value, memory_order_relaxed);
+            return value;
+        }
+
+        static void raisePeak(atomic<long long> &peak, long long live)
+        {
+            if (live > peak.load(memory_order_relaxed))
+            {
+                peak.store(live, memory_order_relaxed);
+            }
+        }
+
+        void addTo(AllocationStats &stats) const
+        {
+            stats.allocations += allocations.load(memory_order_relaxed);
+            stats.frees += frees.load(memory_order_relaxed);
+            stats.live_nodes += live_nodes.load(memory_order_relaxed);
+            stats.peak_nodes += peak_nodes.load(memory_order_relaxed);
+            stats.live_bytes += live_bytes.load(memory_order_relaxed);
+            stats.peak_bytes += peak_bytes.load(memory_order_relaxed);
+            stats.overhead_bytes += overhead_bytes.load(memory_order_relaxed);
+            stats.copies += copies.load(memory_order_relaxed);
+            stats.moves += moves.load(memory_order_relaxed);
+        }
+
+        void clear()
+        {
+            for (atomic<long long> *counter : { &allocations, &frees, &live_nodes,
+                                                 &peak_nodes, &live_bytes, &peak_bytes,
+                                                 &overhead_bytes, &copies, &moves })
+            {
+                counter->store(0, memory_order_relaxed);
+            }
+        }
+    };
+
+    // Registers a thread's shard on first use and retires it at thread exit
+    struct ShardOwner
+    {
+        Shard shard;
+
+        ShardOwner()
+        {
+            instance().attach(&shard);
+        }
+
+        ~ShardOwner()
+        {
+            instance().detach(&shard);
+        }
+    };
+
+    mutex _lock;                    // Guards _shards and _retired
+    vector<Shard *> _shards;        // One per thread that has counted
+    AllocationStats _retired;       // Totals of threads that have exited
+
+    GlobalAllocationStats()
+    {
+    }
+
+    void attach(Shard *shard)
+    {
+        lock_guard<mutex> guard(_lock);
+        _shards.push_back(shard);
+    }
+
+    void detach(Shard *shard)
+    {
+        lock_guard<mutex> guard(_lock);
+        shard->addTo(_retired);
+        _shards.erase(find(_shards.begin(), _shards.end(), shard));
+    }
+
+    static Shard &threadShard()
+    {
+        static thread_local ShardOwner owner;
+        return owner.shard;
+    }
+
+public:
+
+    GlobalAllocationStats(const GlobalAllocationStats &other) = delete;
+    GlobalAllocationStats &operator=(const GlobalAllocationStats &other) = delete;
+
+    static GlobalAllocationStats &instance()
+    {
+        static GlobalAllocationStats stats;
+        return stats;
+    }
+
+    void allocated(long long bytes, long long nodes, long long overhead)
+    {
+        Shard &shard = threadShard();
+        Shard::add(shard.allocations, 1);
+        Shard::raisePeak(shard.peak_nodes, Shard::add(shard.live_nodes, nodes));
+        Shard::raisePeak(shard.peak_bytes, Shard::add(shard.live_bytes, bytes));
+        Shard::add(shard.overhead_bytes, overhead);
+    }
+
+    void freed(long long bytes, long long nodes, long long overhead)
+    {
+        Shard &shard = threadShard();
+        Shard::add(shard.frees, 1);
+        Shard::add(shard.live_nodes, -nodes);
+        Shard::add(shard.live_bytes, -bytes);
+        Shard::add(shard.overhead_bytes, -overhead);
+    }
+
+    void copied()
+    {
+        Shard::add(threadShard().copies, 1);
+    }
+
+    void moved()
+    {
+        Shard::add(threadShard().moves, 1);
+    }
+
+    AllocationStats snapshot()
+    {
+        lock_guard<mutex> guard(_lock);
+        AllocationStats stats = _retired;
+        for (const Shard *shard : _shards)
+        {
+            shard->addTo(stats);
+        }
+        return stats;
+    }
+
+    // Not safe while other threads are counting
+    void reset()
+    {
+        lock_guard<mutex> guard(_lock);
+        _retired = AllocationStats();
+        for (Shard *shard : _shards)
+        {
+            shard->clear();
+        }
+    }
+};
+
+inline void AllocationStats::allocated(long long bytes, long long nodes, long long overhead)
+{
+    allocations++;
+    live_nodes += nodes;
+    live_bytes += bytes;
+    overhead_bytes += overhead;
+    if (live_nodes > peak_nodes)
+    {
+        peak_nodes = live_nodes;
+    }
+    if (live_bytes > peak_bytes)
+    {
+        peak_bytes = live_bytes;
+    }
+    GlobalAllocationStats::instance().allocated(bytes, nodes, overhead);
+}
+
+inline void AllocationStats::freed(long long bytes, long long nodes, long long overhead)
+{
+    frees++;
+    live_nodes -= nodes;
+    live_bytes -= bytes;
+    overhead_bytes -= overhead;
+    GlobalAllocationStats::instance().freed(bytes, nodes, overhead);
+}
+
+inline void AllocationStats::copied()
+{
+    copies++;
+    GlobalAllocationStats::instance().copied();
+}
+
+inline void AllocationStats::moved()
+{
+    moves++;
+    GlobalAllocationStats::instance().moved();
+}
+
+inline void AllocationStats::takeLive(AllocationStats &other)
+{
+    live_nodes += other.live_nodes;
+    live_bytes += other.live_bytes;
+    overhead_bytes += other.overhead_bytes;
+    if (live_nodes > peak_nodes)
+    {
+        peak_nodes = live_nodes;
+    }
+    if (live_bytes > peak_bytes)
+    {
+        peak_bytes = live_bytes;
+    }
+    other.live_nodes = 0;
+    other.live_bytes = 0;
+    other.overhead_bytes = 0;
+}
+
+inline AllocationStats AllocationStats::global()
+{
+    return GlobalAllocationStats::instance().snapshot();
+}
+
+inline void AllocationStats::resetGlobal()
+{
+    GlobalAllocationStats::instance().reset();
+}
+
+#ifdef CONTAINER_STATS
+#define CONTAINER_STATS_RECORD(statement) statement
+#else
+#define CONTAINER_STATS_RECORD(statement) ((void)0)
+#endif
+
+#endif
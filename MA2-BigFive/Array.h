@@ -5,6 +5,8 @@
 #include <exception>
 #include <utility>
 #include "Indexed.h"
+#include "RawStorage.h"
+#include "AllocationStats.h"
 using namespace std;
 
 template <typename T>
@@ -14,7 +16,8 @@ class Array : public Indexed<T>
 protected:
 
 	//_items will handle the actual storage
-	//of our data items.
+	//of our data items.  It is raw memory: only the first
+	//_number_of_items slots hold constructed objects.
 	T *_items;
 
 	//used to store the maximum size of
@@ -25,84 +28,199 @@ protected:
 	//in our array
 	int _number_of_items;
 
+	//allocation counters (see AllocationStats.h); present in every build so
+	//the layout doesn't depend on CONTAINER_STATS
+	AllocationStats _stats;
+
+	//RawStorage::allocate and release, counted in our allocation stats.
+	//release needs the capacity the buffer was allocated with.
+	T *allocateItems(int capacity)
+	{
+		T *items = RawStorage<T>::allocate(capacity);
+		if (items != nullptr)
+		{
+			CONTAINER_STATS_RECORD(_stats.allocated((long long)sizeof(T) * capacity, 0, 0));
+		}
+		return items;
+	}
+
+	void releaseStorage(T *items, int capacity)
+	{
+		if (items != nullptr)
+		{
+			RawStorage<T>::release(items);
+			CONTAINER_STATS_RECORD(_stats.freed((long long)sizeof(T) * capacity, 0, 0));
+		}
+	}
+
+	//true when _items came from RawStorage::allocate.  SmallArray keeps its
+	//first items inside the object, and that space can be neither freed
+	//nor handed over to another array.
+	virtual bool ownsHeapItems() const
+	{
+		return true;
+	}
+
+	//destroys our live items and gives back our storage
+	void releaseItems()
+	{
+		RawStorage<T>::destroy(_items, _number_of_items);
+		if (ownsHeapItems())
+		{
+			releaseStorage(_items, _max_size);
+		}
+		_items = nullptr;
+		_number_of_items = 0;
+	}
+
+	//takes over other's items, leaving it empty; we must hold none.  A
+	//heap buffer is simply stolen.  Items stored inside other are moved
+	//into a buffer of our own, and other keeps its (now empty) space.
+	void takeItems(Array<T> &other)
+	{
+		if (other.ownsHeapItems())
+		{
+			_items = other._items;
+			_max_size = other._max_size;
+			_number_of_items = other._number_of_items;
+			CONTAINER_STATS_RECORD(_stats.takeLive(other._stats));
+			other._items = nullptr;
+			other._max_size = 0;
+			other._number_of_items = 0;
+			return;
+		}
+
+		T *items = allocateItems(other._number_of_items);
+		try
+		{
+			RawStorage<T>::moveConstruct(items, other._items, other._number_of_items);
+		}
+		catch (...)
+		{
+			releaseStorage(items, other._number_of_items);
+			throw;
+		}
+		_items = items;
+		_max_size = other._number_of_items;
+		_number_of_items = other._number_of_items;
+		RawStorage<T>::destroy(other._items, other._number_of_items);
+		other._number_of_items = 0;
+	}
+
+	//builds an item from args at location, which must be in bounds with
+	//room to spare.  Appending constructs straight into the free slot.
+	template <typename... Args>
+	void constructAt(int location, Args &&... args)
+	{
+		if (location == _number_of_items)
+		{
+			new (_items + location) T(std::forward<Args>(args)...);
+			_number_of_items++;
+			return;
+		}
+
+		//args may refer to one of the items we're about to shift, so
+		//build the value before anything moves
+		T value(std::forward<Args>(args)...);
+
+		//shift every item to the right
+		//worst case is location == 0
+		//best case is location == number of items
+		//(trivially copyable items move with a single memmove)
+		RawStorage<T>::shiftRight(_items, _number_of_items, location);
+		_number_of_items++;
+
+		//now that we have a spot for our item, add it to our array
+		_items[location] = std::move(value);
+	}
+
+	//shared bounds checks for addElementAt
+	void checkInsert(int location) const
+	{
+		//make sure that we're not full and that the index is within bounds
+		if (_number_of_items == _max_size)
+		{
+			throw length_error("Array is at max size.");
+		}
+		if (location < 0 || location > _number_of_items)
+		{
+			throw out_of_range("Array index out of bounds.");
+		}
+	}
+
+	//shared bounds check for setElementAt.  Setting the slot just past
+	//our last item appends; anything further out would leave unconstructed
+	//holes, so it is out of bounds.
+	void checkSet(int location) const
+	{
+		if (location < 0 || location > _number_of_items || location >= _max_size)
+		{
+			throw out_of_range("Index out of bounds.");
+		}
+	}
+
 public:
 
 #pragma region constructors / destructors
 
 	//constructor with single input paramter.  Need to initialize using ()
-	//to call this one
+	//to call this one.  No items are constructed until they are added.
 	Array(int max_size)
 	{
 		_max_size = max_size;
 		_number_of_items = 0;
-		_items = new T[_max_size];
+		_items = allocateItems(_max_size);
 	}
 
 	//initializer list constructor
 	Array(initializer_list<T> values)
 	{
-		_max_size = values.size();
+		_max_size = (int)values.size();
 		_number_of_items = 0;
-		_items = new T[_max_size];
+		_items = allocateItems(_max_size);
 
-		//cool C++ 11 way to iterate!
-		for (auto item : values)
-		{
-			addElement(item);
-		}
+		//build each item straight into its slot
+		RawStorage<T>::copyConstruct(_items, values.begin(), _max_size);
+		_number_of_items = _max_size;
 	}
 
-	//Copy constructor.  
+	//Copy constructor.
 	Array(const Array<T> &other)
 		: _items(nullptr)
 	{
-		//don't copy ourselves!
-		if (this != &other)
+		//allocate space for new items
+		_max_size = other.getSize() + 1;
+		_number_of_items = 0;
+		_items = allocateItems(_max_size);
+
+		//copy-construct other's items directly into our storage
+		try
 		{
-			//delete existing contents if they exit
-			if (_items != nullptr)
-			{
-				delete[] _items;
-			}
-
-			//allocate space for new items
-			_max_size = other.getSize() + 1;
-			_number_of_items = other.getSize();
-			_items = new T[_max_size];
-
-			//make copies of other's items
-			for (int i = 0; i < _number_of_items; i++)
-			{
-				T item = other.getElementAt(i);
-				_items[i] = item;
-			}
+			RawStorage<T>::copyConstruct(_items, other._items, other._number_of_items);
 		}
+		catch (...)
+		{
+			releaseStorage(_items, _max_size);
+			throw;
+		}
+		_number_of_items = other._number_of_items;
+		CONTAINER_STATS_RECORD(_stats.copied());
 	}
 
-	//Move constructor. 
+	//Move constructor.  Steals other's pointer (see takeItems).
 	Array(Array<T> &&other)
-		: _items(nullptr)
+		: _items(nullptr), _max_size(0), _number_of_items(0)
 	{
-		//get other's meta data
-		_max_size = other._max_size;
-		_number_of_items = other._number_of_items;
-
-		//then steal its pointer
-		_items = other._items;
-
-		//and give it nullptr instead
-		other._items = nullptr;
+		takeItems(other);
+		CONTAINER_STATS_RECORD(_stats.moved());
 	}
 
 
 	//We need to delcare a destructor because we're dynamically allocating memory
-	//in our constructor
+	//in our constructor.  Only the live items get destroyed.
 	virtual ~Array()
 	{
-		if (_items != nullptr)
-		{
-			delete[] _items;
-		}
+		releaseItems();
 	}
 
 #pragma endregion
@@ -111,31 +229,42 @@ public:
 #pragma region Collection overrides
 
 	//Will return true if we have no items in our Array.  False otherwise.
-	virtual bool isEmpty() const
+	virtual bool isEmpty() const final
 	{
 		return _number_of_items == 0;
 	}
 
-	//Returns the number of items currently in the array.  Note that
-	//there still might be NULL values that exist within this range.
-	virtual int getSize() const
+	//Returns the number of items currently in the array.
+	virtual int getSize() const final
 	{
 		return _number_of_items;
 	}
 
 	//adds an item to the "end" of our array
-	virtual void addElement(T item)
+	virtual void addElement(const T &item)
 	{
 		//add element to the end of our array
 		addElementAt(item, _number_of_items);
 	}
+
+	virtual void addElement(T &&item)
+	{
+		addElementAt(std::move(item), _number_of_items);
+	}
+
+	//constructs an item from args at the "end" of our array
+	template <typename... Args>
+	void emplaceElement(Args &&... args)
+	{
+		emplaceElementAt(_number_of_items, std::forward<Args>(args)...);
+	}
 #pragma endregion
 
 	//methods that originally came from the Indexed interface
 #pragma region Indexed overrides
 
 	//returns the item at the specified index
-	virtual T& getElementAt(int location)
+	virtual T& getElementAt(int location) final
 	{
 		if (location < 0 || location >= _number_of_items)
 		{
@@ -145,7 +274,7 @@ public:
 	}
 
 	//const version of getElementAt
-	virtual const T &getElementAt(int index) const
+	virtual const T &getElementAt(int index) const final
 	{
 		if (index < 0 || index >= _number_of_items)
 		{
@@ -154,55 +283,70 @@ public:
 		return _items[index];
 	}
 
-	//sets the item at the specified index
-	virtual void setElementAt(T value, int location)
+	//sets the item at the specified index (see checkSet)
+	virtual void setElementAt(const T &value, int location) final
 	{
-		if (location < 0 || location >= _max_size)
+		checkSet(location);
+		if (location < _number_of_items)
 		{
-			throw out_of_range("Index out of bounds.");
+			_items[location] = value;
 		}
-		_items[location] = value;
-
-		//if this index is larger than our currently tracked _number_of_items,
-		//replace with specified index
-		if (_number_of_items <= location)
+		else
 		{
-			_number_of_items = location + 1;
+			new (_items + location) T(value);
+			_number_of_items++;
 		}
 	}
 
-	//adds the item at the specified index and shifts all larger items
-	//"right" by one
-	virtual void addElementAt(T value, int location)
+	virtual void setElementAt(T &&value, int location) final
 	{
-		//make sure that we're not full and that the index is within bounds
-		if (location >= _max_size)
+		checkSet(location);
+		if (location < _number_of_items)
 		{
-			throw out_of_range("Array index out of bounds.");
+			_items[location] = std::move(value);
 		}
-		if (_number_of_items == _max_size)
+		else
 		{
-			throw exception("Array is at max size.");
+			new (_items + location) T(std::move(value));
+			_number_of_items++;
 		}
+	}
 
-		//shift every item to the right
-		//worst case is location == 0
-		//best case is location == number of items
-		for (int i = _number_of_items - 1; i >= location; i--)
+	//adds the item at the specified index and shifts all larger items
+	//"right" by one
+	virtual void addElementAt(const T &value, int location)
+	{
+		checkInsert(location);
+		constructAt(location, value);
+	}
+
+	virtual void addElementAt(T &&value, int location)
+	{
+		checkInsert(location);
+		constructAt(location, std::move(value));
+	}
+
+	//constructs an item from args at the specified index.  A full array
+	//hands a finished item to addElementAt, so a Vector (even seen through
+	//an Array reference) grows instead of throwing.
+	template <typename... Args>
+	void emplaceElementAt(int location, Args &&... args)
+	{
+		if (_number_of_items == _max_size)
 		{
-			setElementAt(_items[i], i + 1);
+			addElementAt(T(std::forward<Args>(args)...), location);
+			return;
 		}
-
-		//now that we have a spot for our item, add it to our array
-		setElementAt(value, location);
+		checkInsert(location);
+		constructAt(location, std::forward<Args>(args)...);
 	}
 
-	//removes the item at the specified index and shifts all smaller items
+	//removes the item at the specified index and shifts all larger items
 	//"left" by one
 	virtual void removeElementAt(int index)
 	{
 		//make sure that we're in bounds
-		if (index < 0 || index >= _max_size)
+		if (index < 0 || index >= _number_of_items)
 		{
 			throw out_of_range("Index out of bounds.");
 		}
@@ -211,26 +355,20 @@ public:
 		//worst case: index == 0
 		//best case:  index == number of items
 		//O(N) - N = size of array
-		for (int i = index; i < _number_of_items - 1; i++)
-		{
-			_items[i] = _items[i + 1];
-		}
+		//(trivially copyable items move with a single memmove)
+		RawStorage<T>::shiftLeft(_items, _number_of_items, index);
 
-		//do the last shift if we have room
-		if (_number_of_items + 1 < _max_size)
-		{
-			_items[_number_of_items] = _items[_number_of_items + 1];
-		}
-
-		//decrement the number of items in our array
+		//the old last slot is now a moved-from leftover
 		_number_of_items--;
+		_items[_number_of_items].~T();
 	}
 #pragma endregion
 
 #pragma region Array-specific functions
 
 	//The setSize method for Arrays won't actually change the underlying size of the array.
-	//Instead, it merely readjusts the number of items being tracked in the array.
+	//Instead, it readjusts the number of items being tracked in the array.  Shrinking
+	//destroys the dropped items; growing default-constructs the new ones.
 	virtual void setSize(int size)
 	{
 		//check for exceptions!
@@ -238,38 +376,99 @@ public:
 		{
 			throw out_of_range("Invalid size.");
 		}
+		if (size < _number_of_items)
+		{
+			RawStorage<T>::destroy(_items + size, _number_of_items - size);
+		}
+		else
+		{
+			RawStorage<T>::defaultConstruct(_items + _number_of_items, size - _number_of_items);
+		}
 		_number_of_items = size;
 	}
 
+	//allocation counters for this array; all zero unless built with
+	//CONTAINER_STATS
+	AllocationStats getStats() const
+	{
+		return _stats;
+	}
+
+#pragma endregion
+
+#pragma region iterators
+
+	//items are contiguous, so plain pointers are random-access iterators
+	typedef T *iterator;
+	typedef const T *const_iterator;
+
+	iterator begin()
+	{
+		return _items;
+	}
+
+	iterator end()
+	{
+		return _items + _number_of_items;
+	}
+
+	const_iterator begin() const
+	{
+		return _items;
+	}
+
+	const_iterator end() const
+	{
+		return _items + _number_of_items;
+	}
+
+	const_iterator cbegin() const
+	{
+		return begin();
+	}
+
+	const_iterator cend() const
+	{
+		return end();
+	}
+
 #pragma endregion
 
 #pragma region operator overloads
 
-	//Copy operator 
+	//Copy operator
 	virtual Array<T> & operator=(const Array<T> &other)
 	{
-		//remove existing items if we have any
-		if (this->_items != nullptr)
+		//don't copy ourselves!
+		if (this == &other)
+		{
+			return *this;
+		}
+
+		//build the copy in new space first so a throwing copy leaves us untouched
+		T *items = allocateItems(other._max_size);
+		try
+		{
+			RawStorage<T>::copyConstruct(items, other._items, other._number_of_items);
+		}
+		catch (...)
 		{
-			delete[] _items;
+			releaseStorage(items, other._max_size);
+			throw;
 		}
 
-		//allocate new space
-		_items = new T[other.getSize()];
-		
+		//remove existing items if we have any
+		releaseItems();
+
 		//copy other's meta data
+		_items = items;
 		_max_size = other._max_size;
 		_number_of_items = other._number_of_items;
-
-		//copy other's items
-		for (int i = 0; i < other.getSize(); i++)
-		{
-			setElementAt(other.getElementAt(i), i);
-		}
+		CONTAINER_STATS_RECORD(_stats.copied());
 
 		//Kind of goofy syntax, but we need to return a reference to ourselves.  Recall that
 		//"this" refers to whatever object is calling this code.  Also recall that "this"
-		//is a pointer, so we have to dereference us in order to return ourselves as a 
+		//is a pointer, so we have to dereference us in order to return ourselves as a
 		//reference.
 		return *this;
 	}
@@ -277,34 +476,33 @@ public:
 	//Move operator
 	virtual Array<T> &operator=(Array<T> &&other)
 	{
-		//take care of any information we already have before stealing other's data
-		if (_items != nullptr)
+		//don't move into ourselves!
+		if (this == &other)
 		{
-			delete[] _items;
+			return *this;
 		}
 
-		//get other's meta data
-		_max_size = other._max_size;
-		_number_of_items = other._number_of_items;
-
-		//then steal its pointer
-		_items = other._items;
+		//take care of any information we already have before stealing other's data
+		releaseItems();
+		_max_size = 0;
 
-		//and give it nullptr instead
-		other._items = nullptr;
+		//then steal its pointer (see takeItems)
+		takeItems(other);
+		CONTAINER_STATS_RECORD(_stats.moved());
 
 		//return a reference to ourselves
 		return *this;
 	}
 
-	//shortcut for getElementAt
-	virtual T&  operator[](int index)
+	//shortcut for getElementAt (unchecked).  Not virtual, so loops over
+	//an Array or Vector can inline it.
+	T& operator[](int index)
 	{
 		return _items[index];
 	}
 
 	//shortcut for getElementAt
-	virtual const T& operator[](int index) const
+	const T& operator[](int index) const
 	{
 		return _items[index];
 	}
@@ -312,4 +510,4 @@ public:
 #pragma endregion
 };
 
-#endif
\ No newline at end of file
+#endif
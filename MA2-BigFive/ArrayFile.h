@@ -0,0 +1,76 @@
+/*
+ * ArrayFile.h - On-disk layout shared by the file-backed containers
+ *
+ *  A file holds one ArrayFileHeader followed directly by the items as raw
+ *  bytes, so only trivially copyable types can be stored.  The header is
+ *  64 bytes, which keeps the first item aligned for any fundamental type
+ *  when the whole file is mapped.
+ *
+ *  Files are read back on the machine (or at least the byte order and
+ *  type layout) that wrote them; the header checks the version and the
+ *  item size, nothing more.
+ *
+ */
+
+#ifndef ARRAY_FILE_H
+#define ARRAY_FILE_H
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+using namespace std;
+
+struct ArrayFileHeader
+{
+	//"MA2ARRAY", no terminator
+	char magic[8];
+
+	//bumped whenever the layout changes
+	uint32_t version;
+
+	//sizeof(T) of the writer
+	uint32_t item_size;
+
+	//number of items that follow.  Files may be longer (spare capacity).
+	uint64_t item_count;
+
+	uint8_t reserved[40];
+};
+
+static_assert(sizeof(ArrayFileHeader) == 64, "ArrayFileHeader must stay 64 bytes.");
+
+const uint32_t ARRAY_FILE_VERSION = 1;
+
+//header describing count items of type T
+template <typename T>
+ArrayFileHeader arrayFileHeader(uint64_t count)
+{
+	ArrayFileHeader header;
+	memset(&header, 0, sizeof(header));
+	memcpy(header.magic, "MA2ARRAY", sizeof(header.magic));
+	header.version = ARRAY_FILE_VERSION;
+	header.item_size = (uint32_t)sizeof(T);
+	header.item_count = count;
+	return header;
+}
+
+//throws unless header could have been written by arrayFileHeader<T>.
+//source names the file in the message.
+template <typename T>
+void checkArrayFileHeader(const ArrayFileHeader &header, const string &source)
+{
+	if (memcmp(header.magic, "MA2ARRAY", sizeof(header.magic)) != 0)
+	{
+		throw runtime_error(source + " is not an array file.");
+	}
+	if (header.version != ARRAY_FILE_VERSION)
+	{
+		throw runtime_error(source + " has an unsupported array file version.");
+	}
+	if (header.item_size != sizeof(T))
+	{
+		throw runtime_error(source + " holds items of a different size.");
+	}
+}
+
+#endif
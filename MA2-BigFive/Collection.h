@@ -8,16 +8,33 @@
 #ifndef COLLECTION_H
 #define COLLECTION_H
 
+#include <utility>
+
+//Passed ahead of emplace arguments so node constructors can tell
+//"build the value from these" apart from their copy constructors
+struct EmplaceTag
+{
+};
+
 template <typename T>
 class Collection 
 {
 public:
 
-	//Note that it would probably be more efficient to pass by constant reference,
-	//but for learning purposes, I'm sticking to pass by value.
-	virtual void addElement(T item) = 0;
+	//copies an lvalue in, or moves a temporary in without copying it
+	virtual void addElement(const T &item) = 0;
+	virtual void addElement(T &&item) = 0;
 	virtual bool isEmpty() const = 0;
 	virtual int getSize() const = 0;
+
+	//builds an item from args and adds it.  Templates can't be virtual, so
+	//this version moves a temporary in; containers hide it with one that
+	//constructs straight into their storage.
+	template <typename... Args>
+	void emplaceElement(Args &&... args)
+	{
+		addElement(T(std::forward<Args>(args)...));
+	}
 };
 
 #endif
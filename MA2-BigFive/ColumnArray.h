@@ -0,0 +1,342 @@
+/*
+ * ColumnArray.h - An array of structs stored one column per field
+ *
+ *  Array<Particle> keeps whole Particles side by side, so a scan that reads
+ *  only particle.mass still drags every other field through the cache.
+ *  ColumnArray stores each described field in its own contiguous column
+ *  (a Vector), so that scan reads only the masses.  Those are plain arrays
+ *  of int, float, double, ..., ready for SimdKernels.h.
+ *
+ *  The fields to store are named with COLUMN_FIELD:
+ *
+ *    struct Particle { float x; float y; int id; };
+ *    ColumnArray<Particle, COLUMN_FIELD(Particle, x), COLUMN_FIELD(Particle, y),
+ *                COLUMN_FIELD(Particle, id)> particles;
+ *
+ *  Rows go in and out through an Indexed-like interface (addElement,
+ *  getElementAt, ...) that takes and returns whole structs by value,
+ *  since a row no longer exists in one piece to hand out a reference
+ *  to.  Fields not described are not stored and come back default
+ *  constructed.  column<K>() is a ColumnSpan over field K of every row.
+ *
+ */
+
+#ifndef COLUMN_ARRAY_H
+#define COLUMN_ARRAY_H
+#include <initializer_list>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include "Vector.h"
+using namespace std;
+
+//describes the field Member (of type Field) of struct Row
+template <typename Row, typename Field, Field Row::*Member>
+struct ColumnField
+{
+	typedef Field type;
+
+	static Field &of(Row &row)
+	{
+		return row.*Member;
+	}
+
+	static const Field &of(const Row &row)
+	{
+		return row.*Member;
+	}
+};
+
+#define COLUMN_FIELD(Row, member) ColumnField<Row, decltype(Row::member), &Row::member>
+
+//a view of one column: contiguous items, valid until rows are added or
+//removed
+template <typename T>
+class ColumnSpan
+{
+	T *_items;
+	int _size;
+
+public:
+
+	ColumnSpan(T *items, int size)
+		: _items(items), _size(size)
+	{
+	}
+
+	int getSize() const
+	{
+		return _size;
+	}
+
+	bool isEmpty() const
+	{
+		return _size == 0;
+	}
+
+	//unchecked, like Array's operator[]
+	T &operator[](int index) const
+	{
+		return _items[index];
+	}
+
+	T *data() const
+	{
+		return _items;
+	}
+
+	T *begin() const
+	{
+		return _items;
+	}
+
+	T *end() const
+	{
+		return _items + _size;
+	}
+};
+
+template <typename Row, typename... Fields>
+class ColumnArray
+{
+public:
+
+	static const int FIELD_COUNT = (int)sizeof...(Fields);
+
+	//descriptor and item type of field K
+	template <int K>
+	struct FieldAt
+	{
+		typedef typename tuple_element<K, tuple<Fields...> >::type field;
+		typedef typename field::type type;
+	};
+
+protected:
+
+	template <int K>
+	struct FieldIndex
+	{
+	};
+
+	tuple<Vector<typename Fields::type>...> _columns;
+	int _number_of_items = 0;
+
+	template <int K>
+	Vector<typename FieldAt<K>::type> &columnAt()
+	{
+		return get<K>(_columns);
+	}
+
+	template <int K>
+	const Vector<typename FieldAt<K>::type> &columnAt() const
+	{
+		return get<K>(_columns);
+	}
+
+	//each of the helpers below does field K, then the fields after it
+
+	//inserts row's fields at location.  If a field copy throws, the
+	//fields already inserted are taken out again, so the columns stay
+	//in step.
+	template <int K>
+	void insertFields(const Row &row, int location, FieldIndex<K>)
+	{
+		columnAt<K>().addElementAt(FieldAt<K>::field::of(row), location);
+		try
+		{
+			insertFields(row, location, FieldIndex<K + 1>());
+		}
+		catch (...)
+		{
+			columnAt<K>().removeElementAt(location);
+			throw;
+		}
+	}
+
+	void insertFields(const Row &, int, FieldIndex<FIELD_COUNT>)
+	{
+	}
+
+	template <int K>
+	void readFields(Row &row, int location, FieldIndex<K>) const
+	{
+		FieldAt<K>::field::of(row) = columnAt<K>()[location];
+		readFields(row, location, FieldIndex<K + 1>());
+	}
+
+	void readFields(Row &, int, FieldIndex<FIELD_COUNT>) const
+	{
+	}
+
+	template <int K>
+	void writeFields(const Row &row, int location, FieldIndex<K>)
+	{
+		columnAt<K>()[location] = FieldAt<K>::field::of(row);
+		writeFields(row, location, FieldIndex<K + 1>());
+	}
+
+	void writeFields(const Row &, int, FieldIndex<FIELD_COUNT>)
+	{
+	}
+
+	template <int K>
+	void removeFields(int location, FieldIndex<K>)
+	{
+		columnAt<K>().removeElementAt(location);
+		removeFields(location, FieldIndex<K + 1>());
+	}
+
+	void removeFields(int, FieldIndex<FIELD_COUNT>)
+	{
+	}
+
+	template <int K>
+	void reserveFields(int capacity, FieldIndex<K>)
+	{
+		columnAt<K>().reserve(capacity);
+		reserveFields(capacity, FieldIndex<K + 1>());
+	}
+
+	void reserveFields(int, FieldIndex<FIELD_COUNT>)
+	{
+	}
+
+	template <int K>
+	void clearFields(FieldIndex<K>)
+	{
+		columnAt<K>().setSize(0);
+		clearFields(FieldIndex<K + 1>());
+	}
+
+	void clearFields(FieldIndex<FIELD_COUNT>)
+	{
+	}
+
+	void checkIndex(int location) const
+	{
+		if (location < 0 || location >= _number_of_items)
+		{
+			throw out_of_range("Index out of range.");
+		}
+	}
+
+public:
+
+#pragma region constructors / destructors
+
+	ColumnArray()
+	{
+	}
+
+	ColumnArray(initializer_list<Row> rows)
+	{
+		reserve((int)rows.size());
+		for (const Row &row : rows)
+		{
+			addElement(row);
+		}
+	}
+
+#pragma endregion
+
+#pragma region row interface
+
+	bool isEmpty() const
+	{
+		return _number_of_items == 0;
+	}
+
+	int getSize() const
+	{
+		return _number_of_items;
+	}
+
+	void addElement(const Row &row)
+	{
+		addElementAt(row, _number_of_items);
+	}
+
+	//inserts row at location, shifting the rows after it in every column
+	void addElementAt(const Row &row, int location)
+	{
+		if (location < 0 || location > _number_of_items)
+		{
+			throw out_of_range("Index out of bounds.");
+		}
+		insertFields(row, location, FieldIndex<0>());
+		_number_of_items++;
+	}
+
+	//gathers the row at location from the columns
+	Row getElementAt(int location) const
+	{
+		checkIndex(location);
+		Row row = Row();
+		readFields(row, location, FieldIndex<0>());
+		return row;
+	}
+
+	void setElementAt(const Row &row, int location)
+	{
+		checkIndex(location);
+		writeFields(row, location, FieldIndex<0>());
+	}
+
+	void removeElementAt(int location)
+	{
+		checkIndex(location);
+		removeFields(location, FieldIndex<0>());
+		_number_of_items--;
+	}
+
+	//makes room for capacity rows in every column
+	void reserve(int capacity)
+	{
+		reserveFields(capacity, FieldIndex<0>());
+	}
+
+	void clear()
+	{
+		clearFields(FieldIndex<0>());
+		_number_of_items = 0;
+	}
+
+#pragma endregion
+
+#pragma region column interface
+
+	//field K of every row, in row order
+	template <int K>
+	ColumnSpan<typename FieldAt<K>::type> column()
+	{
+		return ColumnSpan<typename FieldAt<K>::type>(columnAt<K>().begin(), _number_of_items);
+	}
+
+	template <int K>
+	ColumnSpan<const typename FieldAt<K>::type> column() const
+	{
+		return ColumnSpan<const typename FieldAt<K>::type>(columnAt<K>().begin(), _number_of_items);
+	}
+
+	//field K of the row at location
+	template <int K>
+	typename FieldAt<K>::type &getField(int location)
+	{
+		checkIndex(location);
+		return columnAt<K>()[location];
+	}
+
+	template <int K>
+	const typename FieldAt<K>::type &getField(int location) const
+	{
+		checkIndex(location);
+		return columnAt<K>()[location];
+	}
+
+#pragma endregion
+};
+
+template <typename Row, typename... Fields>
+const int ColumnArray<Row, Fields...>::FIELD_COUNT;
+
+#endif
@@ -0,0 +1,325 @@
+/*
+ * ConcurrentLinkedList.h - Thread-safe singly linked list with per-node locks
+ *
+ *  Every node carries its own mutex, and threads walk the list
+ *  hand-over-hand: the next node is locked before the current one is
+ *  released.  Threads always lock in list order, so they never deadlock,
+ *  and two threads only wait on each other when they reach the same
+ *  nodes.  Readers and writers in different regions of the list run in
+ *  parallel.
+ *
+ *  The list keeps two sentinels.  The front sentinel gives index 0 a
+ *  predecessor to lock.  The end sentinel is the empty node after the
+ *  last value: appending writes the value into it and links a fresh
+ *  sentinel behind it, so addElement only locks the end of the list.
+ *
+ *  LinkedList's shared _last_accessed_* cache would race here, so there
+ *  is none.  A thread walking the list keeps its own Cursor instead; the
+ *  index operations are single cursor walks from the front.
+ *
+ *  Values are handed out by copy, since a reference would outlive the
+ *  lock protecting it.  T must be default constructible (the end
+ *  sentinel holds a T()).
+ *
+ */
+
+#ifndef CONCURRENT_LINKED_LIST_H
+#define CONCURRENT_LINKED_LIST_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <utility>
+
+#include "ListNode.h"
+
+using namespace std;
+
+// A ListNode with a lock of its own
+template <typename T>
+class ConcurrentListNode : public ListNode<T>
+{
+private:
+    mutex _lock;
+
+public:
+
+    ConcurrentListNode() : ListNode<T>()
+    {
+    }
+
+    template <typename... Args>
+    ConcurrentListNode(EmplaceTag tag, Args &&... args)
+        : ListNode<T>(tag, std::forward<Args>(args)...)
+    {
+    }
+
+    ConcurrentListNode<T> *getNextNode() const
+    {
+        return static_cast<ConcurrentListNode<T> *>(this->_next);
+    }
+
+    // Only the end sentinel has no next node
+    bool isEndSentinel() const
+    {
+        return this->_next == nullptr;
+    }
+
+    void lock()
+    {
+        _lock.lock();
+    }
+
+    void unlock()
+    {
+        _lock.unlock();
+    }
+};
+
+template <typename T>
+class ConcurrentLinkedList
+{
+//*****************************************************************************
+private:
+    typedef ConcurrentListNode<T> Node;
+
+    Node *_front;                   // Front sentinel, never holds a value
+    Node *_end;                     // End sentinel, guarded by _end_lock
+    mutex _end_lock;                // Taken before _end's own lock
+    atomic<int> _size;
+
+//*****************************************************************************
+public:
+
+    // A position in the list owned by one thread.  The cursor keeps the
+    //  node it is on locked, so no other thread can change or remove that
+    //  node, or get past it, until the cursor moves on or is destroyed.
+    //  A new cursor sits on the front sentinel, just before index 0.
+    //  A thread holding a cursor must not open a second one or call the
+    //  list's index operations until it is done: it would wait on itself.
+    class Cursor
+    {
+    private:
+        ConcurrentLinkedList<T> *_list;
+        Node *_node;
+        int _index;
+
+    public:
+
+        Cursor(ConcurrentLinkedList<T> &list) : _list(&list), _node(list._front), _index(-1)
+        {
+            _node->lock();
+        }
+
+        Cursor(const Cursor &other) = delete;
+        Cursor &operator=(const Cursor &other) = delete;
+
+        ~Cursor()
+        {
+            _node->unlock();
+        }
+
+        // Index of the value under the cursor, -1 before the first one
+        int getIndex() const
+        {
+            return _index;
+        }
+
+        // Steps onto the next value.  Returns false, without moving, at the
+        //  end of the list.
+        bool next()
+        {
+            Node *next = _node->getNextNode();
+            next->lock();
+            if (next->isEndSentinel())
+            {
+                next->unlock();
+                return false;
+            }
+            _node->unlock();
+            _node = next;
+            _index++;
+            return true;
+        }
+
+        // Steps forward count values; false if the list ran out first
+        bool advance(int count)
+        {
+            for (int i = 0; i < count; i++)
+            {
+                if (!next())
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        // Goes back before index 0, letting go of the current node
+        void reset()
+        {
+            _node->unlock();
+            _node = _list->_front;
+            _node->lock();
+            _index = -1;
+        }
+
+        // The value under the cursor; the reference is only safe to use
+        //  until the cursor moves
+        T &getValue()
+        {
+            if (_index < 0)
+            {
+                throw out_of_range("Cursor is before the first element.");
+            }
+            return _node->getValue();
+        }
+
+        // Inserts a value right after the cursor; the cursor stays put.
+        //  Only our node's link changes, so the next node needs no lock.
+        template <typename... Args>
+        void emplaceAfter(Args &&... args)
+        {
+            Node *node = new Node(EmplaceTag(), std::forward<Args>(args)...);
+            node->setNext(_node->getNext());
+            _node->setNext(node);
+            _list->_size.fetch_add(1, memory_order_relaxed);
+        }
+
+        // Unlinks the value after the cursor.  Returns false if there is none.
+        bool removeNext()
+        {
+            Node *next = _node->getNextNode();
+            next->lock();
+            if (next->isEndSentinel())
+            {
+                next->unlock();
+                return false;
+            }
+            _node->setNext(next->getNext());
+            next->unlock();
+            _list->_size.fetch_sub(1, memory_order_relaxed);
+
+            // Any other thread would have to get past our node to reach it
+            delete next;
+            return true;
+        }
+    };
+
+    ConcurrentLinkedList() : _size(0)
+    {
+        _end = new Node();
+        _front = new Node();
+        _front->setNext(_end);
+    }
+
+    ConcurrentLinkedList(const ConcurrentLinkedList<T> &other) = delete;
+    ConcurrentLinkedList<T> &operator=(const ConcurrentLinkedList<T> &other) = delete;
+
+    // No other thread may be using the list by now
+    virtual ~ConcurrentLinkedList()
+    {
+        Node *current = _front;
+        while (current != nullptr)
+        {
+            Node *next = current->getNextNode();
+            delete current;
+            current = next;
+        }
+    }
+
+    // Only a hint while other threads are adding or removing
+    bool isEmpty() const
+    {
+        return getSize() == 0;
+    }
+
+    int getSize() const
+    {
+        return _size.load(memory_order_relaxed);
+    }
+
+    void addElement(const T &value)
+    {
+        emplaceElement(value);
+    }
+
+    void addElement(T &&value)
+    {
+        emplaceElement(std::move(value));
+    }
+
+    // Appends by filling the end sentinel and linking a new one after it.
+    //  Walkers that reach the old sentinel wait on its lock and then see
+    //  the value and the new link together.
+    //  If building or storing the value throws, nothing is linked and both
+    //  locks are let go.
+    template <typename... Args>
+    void emplaceElement(Args &&... args)
+    {
+        T value(std::forward<Args>(args)...);
+        unique_ptr<Node> sentinel(new Node());
+
+        lock_guard<mutex> guard(_end_lock);
+        Node *end = _end;
+        lock_guard<Node> end_guard(*end);
+        end->setValue(std::move(value));
+        end->setNext(sentinel.get());
+        _end = sentinel.release();
+        _size.fetch_add(1, memory_order_relaxed);
+    }
+
+    // Returns a copy of the value at index
+    T getElementAt(int index)
+    {
+        Cursor cursor(*this);
+        if (index < 0 || !cursor.advance(index + 1))
+        {
+            throw out_of_range("Invalid index.");
+        }
+        return cursor.getValue();
+    }
+
+    void setElementAt(const T &value, int index)
+    {
+        Cursor cursor(*this);
+        if (index < 0 || !cursor.advance(index + 1))
+        {
+            throw out_of_range("Invalid index.");
+        }
+        cursor.getValue() = value;
+    }
+
+    void addElementAt(const T &value, int index)
+    {
+        emplaceElementAt(index, value);
+    }
+
+    void addElementAt(T &&value, int index)
+    {
+        emplaceElementAt(index, std::move(value));
+    }
+
+    template <typename... Args>
+    void emplaceElementAt(int index, Args &&... args)
+    {
+        Cursor cursor(*this);
+        if (index < 0 || !cursor.advance(index))
+        {
+            throw out_of_range("Invalid index.");
+        }
+        cursor.emplaceAfter(std::forward<Args>(args)...);
+    }
+
+    void removeElementAt(int index)
+    {
+        Cursor cursor(*this);
+        if (index < 0 || !cursor.advance(index) || !cursor.removeNext())
+        {
+            throw out_of_range("Invalid index.");
+        }
+    }
+};
+
+#endif
@@ -0,0 +1,222 @@
+/*
+ * ConcurrentQueue.h - Lock-free multi-producer/multi-consumer FIFO queue
+ *
+ *  Michael & Scott's queue built from ListNode<T> links.  The queue always
+ *  holds one dummy node at the head; the values are in the nodes after
+ *  it.  push links a node after the tail with a compare-and-swap on its
+ *  next pointer and then swings the tail; tryPop swings the head one node
+ *  forward and takes the value out of the node that becomes the new
+ *  dummy.  Threads that find the tail lagging help move it along, so no
+ *  thread ever waits on another.
+ *
+ *  Unlinked nodes go through HazardPointers, so a node is never freed
+ *  while another thread may still be reading it.
+ *
+ *  T must be default constructible (the dummy node holds a T()).
+ *
+ */
+
+#ifndef CONCURRENT_QUEUE_H
+#define CONCURRENT_QUEUE_H
+
+#include <atomic>
+#include <utility>
+
+#include "HazardPointers.h"
+#include "LinkedList.h"
+#include "ListNode.h"
+
+using namespace std;
+
+// A ListNode whose next link is read and swapped atomically
+template <typename T>
+class ConcurrentQueueNode : public ListNode<T>
+{
+public:
+
+    ConcurrentQueueNode() : ListNode<T>()
+    {
+    }
+
+    template <typename... Args>
+    ConcurrentQueueNode(EmplaceTag tag, Args &&... args)
+        : ListNode<T>(tag, std::forward<Args>(args)...)
+    {
+    }
+
+    // The node returned may already be freed unless the caller has since
+    //  checked that we are still linked in, so it is only cast (which may
+    //  read its vtable) after that check
+    ListNode<T> *loadNext() const
+    {
+        return __atomic_load_n(&this->_next, __ATOMIC_ACQUIRE);
+    }
+
+    // Links desired after us if we are still the last node
+    bool linkNext(ConcurrentQueueNode<T> *desired)
+    {
+        ListNode<T> *expected = nullptr;
+        return __atomic_compare_exchange_n(&this->_next, &expected, desired, false,
+                                           __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+    }
+};
+
+template <typename T>
+class ConcurrentQueue
+{
+private:
+    typedef ConcurrentQueueNode<T> Node;
+
+    // Hazard slots used by push/tryPop
+    static const int HAZARD_FIRST = 0;
+    static const int HAZARD_NEXT = 1;
+
+    // head and tail sit on separate cache lines so producers and
+    //  consumers don't contend on the same line
+    alignas(64) atomic<Node *> _head;
+    alignas(64) atomic<Node *> _tail;
+    alignas(64) atomic<long> _size;
+
+    void linkNode(Node *node)
+    {
+        HazardPointers &hazards = HazardPointers::instance();
+        while (true)
+        {
+            Node *tail = hazards.protect(HAZARD_FIRST, _tail);
+            ListNode<T> *next = tail->loadNext();
+            if (tail != _tail.load(memory_order_acquire))
+            {
+                continue;
+            }
+            if (next != nullptr)
+            {
+                // Tail is lagging behind; help move it before retrying
+                _tail.compare_exchange_weak(tail, static_cast<Node *>(next));
+                continue;
+            }
+            if (tail->linkNext(node))
+            {
+                _tail.compare_exchange_strong(tail, node);
+                break;
+            }
+        }
+        hazards.clear(HAZARD_FIRST);
+        _size.fetch_add(1, memory_order_relaxed);
+    }
+
+public:
+
+    ConcurrentQueue()
+    {
+        Node *dummy = new Node();
+        _head.store(dummy, memory_order_relaxed);
+        _tail.store(dummy, memory_order_relaxed);
+        _size.store(0, memory_order_relaxed);
+    }
+
+    ConcurrentQueue(const ConcurrentQueue<T> &other) = delete;
+    ConcurrentQueue<T> &operator=(const ConcurrentQueue<T> &other) = delete;
+
+    // No other thread may be using the queue by now
+    ~ConcurrentQueue()
+    {
+        Node *current = _head.load(memory_order_acquire);
+        while (current != nullptr)
+        {
+            Node *next = static_cast<Node *>(current->loadNext());
+            delete current;
+            current = next;
+        }
+    }
+
+    void push(const T &value)
+    {
+        linkNode(new Node(EmplaceTag(), value));
+    }
+
+    void push(T &&value)
+    {
+        linkNode(new Node(EmplaceTag(), std::move(value)));
+    }
+
+    template <typename... Args>
+    void emplace(Args &&... args)
+    {
+        linkNode(new Node(EmplaceTag(), std::forward<Args>(args)...));
+    }
+
+    // Moves the oldest value into out.  Returns false if the queue was empty.
+    bool tryPop(T &out)
+    {
+        HazardPointers &hazards = HazardPointers::instance();
+        Node *head = nullptr;
+        Node *next = nullptr;
+        while (true)
+        {
+            head = hazards.protect(HAZARD_FIRST, _head);
+            Node *tail = _tail.load(memory_order_acquire);
+            ListNode<T> *link = head->loadNext();
+            hazards.setHazard(HAZARD_NEXT, link);
+            if (head != _head.load(memory_order_seq_cst))
+            {
+                continue;
+            }
+            next = static_cast<Node *>(link);
+            if (next == nullptr)
+            {
+                hazards.clear(HAZARD_FIRST);
+                hazards.clear(HAZARD_NEXT);
+                return false;
+            }
+            if (head == tail)
+            {
+                // Tail still points at the node we are about to unlink
+                _tail.compare_exchange_weak(tail, next);
+                continue;
+            }
+            if (_head.compare_exchange_strong(head, next))
+            {
+                break;
+            }
+        }
+
+        // next is the new dummy.  Only the winner of the swing above touches
+        //  its value, and our hazard keeps it alive while we do.
+        out = std::move(next->getValue());
+        hazards.clear(HAZARD_FIRST);
+        hazards.clear(HAZARD_NEXT);
+        hazards.retire(head);
+        _size.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    // Pops everything currently in the queue onto the end of list and
+    //  returns how many values were moved.  Values pushed while draining
+    //  may or may not be included.
+    int drainInto(LinkedList<T> &list)
+    {
+        int moved = 0;
+        T value;
+        while (tryPop(value))
+        {
+            list.addElement(std::move(value));
+            moved++;
+        }
+        return moved;
+    }
+
+    // Only a hint while other threads are pushing or popping
+    bool isEmpty() const
+    {
+        return getApproximateSize() <= 0;
+    }
+
+    // Pushes minus pops so far.  Exact when the queue is quiet; while
+    //  threads are working it may be briefly off (even negative).
+    long getApproximateSize() const
+    {
+        return _size.load(memory_order_relaxed);
+    }
+};
+
+#endif
@@ -0,0 +1,409 @@
+/*
+ * DoublyLinkedList.h - Doubly linked list with a multi-finger cursor cache
+ *
+ *  LinkedList can only resume a walk forward from its single last-accessed
+ *  node.  Here every node links both ways, and the list remembers several
+ *  recently used positions ("fingers").  A lookup starts from whichever of
+ *  the front, the end or a finger is closest and walks in either
+ *  direction, so backward scans, alternating ends and a few interleaved
+ *  cursors all stay cheap.
+ *
+ *  The fingers are a cache, not part of the list's value, so they are
+ *  mutable and the const accessors update them too.
+ *
+ */
+
+#ifndef DOUBLY_LINKED_LIST_H
+#define DOUBLY_LINKED_LIST_H
+
+#include <cstdlib>
+#include <initializer_list>
+#include <stdexcept>
+#include <utility>
+
+#include "Indexed.h"
+#include "DoublyListNode.h"
+#include "ListIterator.h"
+
+using namespace std;
+
+template <typename T>
+class DoublyLinkedList : public Indexed<T>
+{
+public:
+    static const int FINGER_COUNT = 4;
+
+//*****************************************************************************
+private:
+    typedef DoublyListNode<T> Node;
+
+    Node *_front = nullptr;                     // Head of list pointer
+    Node *_end = nullptr;                       // End of list pointer
+    int _size = 0;                              // Running count of nodes
+
+    // Cached positions; a nullptr node marks an unused finger
+    mutable Node *_finger_nodes[FINGER_COUNT];
+    mutable int _finger_indexes[FINGER_COUNT];
+    mutable int _next_finger = 0;               // Round-robin replacement
+
+    void forgetFingers()
+    {
+        for (int i = 0; i < FINGER_COUNT; i++)
+        {
+            _finger_nodes[i] = nullptr;
+            _finger_indexes[i] = 0;
+        }
+        _next_finger = 0;
+    }
+
+    // Finds the node at index starting from the closest known position.
+    //  The finger we started from follows the walk, so a scan in either
+    //  direction keeps reusing it; otherwise a new finger is recorded.
+    Node *getNodeAtIndex(int index) const
+    {
+        if (index < 0 || index >= _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+
+        Node *current = _front;
+        int position = 0;
+        int distance = index;
+        int finger = -1;
+        if (_size - 1 - index < distance)
+        {
+            current = _end;
+            position = _size - 1;
+            distance = _size - 1 - index;
+        }
+        for (int i = 0; i < FINGER_COUNT; i++)
+        {
+            if (_finger_nodes[i] != nullptr && abs(_finger_indexes[i] - index) < distance)
+            {
+                current = _finger_nodes[i];
+                position = _finger_indexes[i];
+                distance = abs(position - index);
+                finger = i;
+            }
+        }
+
+        while (position < index)
+        {
+            current = current->getNextNode();
+            position++;
+        }
+        while (position > index)
+        {
+            current = current->getPrev();
+            position--;
+        }
+
+        if (finger < 0)
+        {
+            finger = _next_finger;
+            _next_finger = (_next_finger + 1) % FINGER_COUNT;
+        }
+        _finger_nodes[finger] = current;
+        _finger_indexes[finger] = index;
+        return current;
+    }
+
+    // Keeps fingers pointing at the same nodes after an insert at index
+    void fingersAfterInsert(int index)
+    {
+        for (int i = 0; i < FINGER_COUNT; i++)
+        {
+            if (_finger_nodes[i] != nullptr && _finger_indexes[i] >= index)
+            {
+                _finger_indexes[i]++;
+            }
+        }
+    }
+
+    // Shifts fingers after a removal at index.  Fingers on the removed node
+    //  slide to the node that took its place (or the one before it at the
+    //  end of the list), so repeated removals near one spot stay cheap.
+    void fingersAfterRemove(int index, Node *after, Node *before)
+    {
+        for (int i = 0; i < FINGER_COUNT; i++)
+        {
+            if (_finger_nodes[i] == nullptr)
+            {
+                continue;
+            }
+            if (_finger_indexes[i] == index)
+            {
+                _finger_nodes[i] = after != nullptr ? after : before;
+                _finger_indexes[i] = after != nullptr ? index : index - 1;
+            }
+            else if (_finger_indexes[i] > index)
+            {
+                _finger_indexes[i]--;
+            }
+        }
+    }
+
+    void appendAll(const DoublyLinkedList<T> &other)
+    {
+        for (const Node *node = other._front; node != nullptr; node = node->getNextNode())
+        {
+            addElement(node->getValue());
+        }
+    }
+
+    void stealFrom(DoublyLinkedList<T> &other)
+    {
+        _front = other._front;
+        _end = other._end;
+        _size = other._size;
+        for (int i = 0; i < FINGER_COUNT; i++)
+        {
+            _finger_nodes[i] = other._finger_nodes[i];
+            _finger_indexes[i] = other._finger_indexes[i];
+        }
+        _next_finger = other._next_finger;
+
+        other._front = nullptr;
+        other._end = nullptr;
+        other._size = 0;
+        other.forgetFingers();
+    }
+
+//*****************************************************************************
+public:
+    typedef ListIterator<T, false> iterator;
+    typedef ListIterator<T, true> const_iterator;
+
+    DoublyLinkedList()
+    {
+        forgetFingers();
+    }
+
+    DoublyLinkedList(const DoublyLinkedList<T> &other)
+    {
+        forgetFingers();
+        appendAll(other);
+    }
+
+    DoublyLinkedList(DoublyLinkedList<T> &&other)
+    {
+        stealFrom(other);
+    }
+
+    DoublyLinkedList(initializer_list<T> values)
+    {
+        forgetFingers();
+        for (auto item : values)
+        {
+            addElement(item);
+        }
+    }
+
+    virtual ~DoublyLinkedList()
+    {
+        clear();
+    }
+
+    virtual DoublyLinkedList<T> &operator=(const DoublyLinkedList<T> &other)
+    {
+        if (this != &other)
+        {
+            clear();
+            appendAll(other);
+        }
+        return *this;
+    }
+
+    virtual DoublyLinkedList<T> &operator=(DoublyLinkedList<T> &&other)
+    {
+        if (this != &other)
+        {
+            clear();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    // Deletes every node in one pass
+    void clear()
+    {
+        Node *current = _front;
+        while (current != nullptr)
+        {
+            Node *next = current->getNextNode();
+            delete current;
+            current = next;
+        }
+        _front = nullptr;
+        _end = nullptr;
+        _size = 0;
+        forgetFingers();
+    }
+
+    ListNode<T> *getFront() const
+    {
+        return _front;
+    }
+
+    virtual bool isEmpty() const final
+    {
+        return _size == 0;
+    }
+
+    virtual int getSize() const final
+    {
+        return _size;
+    }
+
+    virtual void addElement(const T &value)
+    {
+        emplaceElementAt(_size, value);
+    }
+
+    virtual void addElement(T &&value)
+    {
+        emplaceElementAt(_size, std::move(value));
+    }
+
+    template <typename... Args>
+    void emplaceElement(Args &&... args)
+    {
+        emplaceElementAt(_size, std::forward<Args>(args)...);
+    }
+
+    virtual T &getElementAt(int index) final
+    {
+        return getNodeAtIndex(index)->getValue();
+    }
+
+    virtual const T &getElementAt(int index) const final
+    {
+        return getNodeAtIndex(index)->getValue();
+    }
+
+    virtual void setElementAt(const T &value, int index) final
+    {
+        getNodeAtIndex(index)->setValue(value);
+    }
+
+    virtual void setElementAt(T &&value, int index) final
+    {
+        getNodeAtIndex(index)->setValue(std::move(value));
+    }
+
+    virtual void addElementAt(const T &value, int index)
+    {
+        emplaceElementAt(index, value);
+    }
+
+    virtual void addElementAt(T &&value, int index)
+    {
+        emplaceElementAt(index, std::move(value));
+    }
+
+    // Builds the new node's value straight from args
+    template <typename... Args>
+    void emplaceElementAt(int index, Args &&... args)
+    {
+        if (index < 0 || index > _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+
+        Node *node = new Node(EmplaceTag(), std::forward<Args>(args)...);
+        if (index == _size)
+        {
+            // Adding to the end (or to an empty list)
+            node->setPrev(_end);
+            if (_end == nullptr)
+            {
+                _front = node;
+            }
+            else
+            {
+                _end->setNext(node);
+            }
+            _end = node;
+        }
+        else
+        {
+            // Adding in front of the node currently at index
+            Node *after = getNodeAtIndex(index);
+            Node *before = after->getPrev();
+            node->setNext(after);
+            node->setPrev(before);
+            after->setPrev(node);
+            if (before == nullptr)
+            {
+                _front = node;
+            }
+            else
+            {
+                before->setNext(node);
+            }
+        }
+
+        fingersAfterInsert(index);
+        _size++;
+    }
+
+    virtual void removeElementAt(int index)
+    {
+        Node *node = getNodeAtIndex(index);
+        Node *before = node->getPrev();
+        Node *after = node->getNextNode();
+
+        if (before == nullptr)
+        {
+            _front = after;
+        }
+        else
+        {
+            before->setNext(after);
+        }
+        if (after == nullptr)
+        {
+            _end = before;
+        }
+        else
+        {
+            after->setPrev(before);
+        }
+
+        fingersAfterRemove(index, after, before);
+        _size--;
+        delete node;
+    }
+
+    iterator begin()
+    {
+        return iterator(_front);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_front);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+#endif
@@ -0,0 +1,68 @@
+/*
+ * DoublyListNode.h - A ListNode that also links back to its predecessor
+ *
+ *  The forward link is the one inherited from ListNode, so ListIterator
+ *  and anything else that walks getNext() works on a doubly linked chain
+ *  unchanged.
+ *
+ */
+
+#ifndef DOUBLY_LIST_NODE_H
+#define DOUBLY_LIST_NODE_H
+
+#include <utility>
+
+#include "ListNode.h"
+
+template <typename T>
+class DoublyListNode : public ListNode<T>
+{
+protected:
+
+    DoublyListNode<T> *_prev;   // Pointer to previous node in the sequence
+
+public:
+
+    DoublyListNode(const T &value) : ListNode<T>(value)
+    {
+        _prev = nullptr;
+    }
+
+    // Builds the value in place from args
+    template <typename... Args>
+    DoublyListNode(EmplaceTag tag, Args &&... args)
+        : ListNode<T>(tag, std::forward<Args>(args)...)
+    {
+        _prev = nullptr;
+    }
+
+    DoublyListNode() : ListNode<T>()
+    {
+        _prev = nullptr;
+    }
+
+    virtual ~DoublyListNode()
+    {
+        _prev = nullptr;
+    }
+
+    // Next node, already cast back to a DoublyListNode
+    DoublyListNode<T> *getNextNode() const
+    {
+        return static_cast<DoublyListNode<T> *>(this->getNext());
+    }
+
+    // Returns a pointer to the previous list node in the sequence
+    DoublyListNode<T> *getPrev() const
+    {
+        return _prev;
+    }
+
+    // Sets the pointer to the previous node in the sequence
+    void setPrev(DoublyListNode<T> *prev)
+    {
+        _prev = prev;
+    }
+};
+
+#endif
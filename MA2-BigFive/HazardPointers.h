@@ -0,0 +1,235 @@
+/*
+ * HazardPointers.h - Safe memory reclamation for lock-free containers
+ *
+ *  A thread that is about to dereference a shared node first publishes the
+ *  node's address in one of its hazard slots.  A node unlinked from a
+ *  lock-free structure is not deleted right away but "retired"; retired
+ *  nodes are only freed once no thread has them in a hazard slot.
+ *
+ *  Each thread claims a record of SLOTS_PER_THREAD hazard slots on first
+ *  use and gives it back when it exits.  Retired nodes collect in a
+ *  per-thread list that is scanned once it reaches SCAN_THRESHOLD, which
+ *  keeps the cost of reclamation amortized O(1) per retired node.
+ *
+ */
+
+#ifndef HAZARD_POINTERS_H
+#define HAZARD_POINTERS_H
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+using namespace std;
+
+class HazardPointers
+{
+public:
+    static const int MAX_THREADS = 128;         // Threads using it at one time
+    static const int SLOTS_PER_THREAD = 2;
+    static const int SCAN_THRESHOLD = 2 * MAX_THREADS * SLOTS_PER_THREAD;
+
+private:
+    struct Retired
+    {
+        void *pointer;
+        void (*deleter)(void *);
+    };
+
+    // Hazard slots of one thread.  Padded to a cache line so threads
+    //  publishing hazards don't invalidate each other's slots.
+    struct alignas(64) Record
+    {
+        atomic<bool> in_use;
+        atomic<void *> hazards[SLOTS_PER_THREAD];
+    };
+
+    // Per-thread bookkeeping; hands the record back when the thread exits
+    struct ThreadState
+    {
+        Record *record = nullptr;
+        vector<Retired> retired;
+
+        ~ThreadState()
+        {
+            if (record != nullptr)
+            {
+                HazardPointers::instance().releaseThread(*this);
+            }
+        }
+    };
+
+    Record _records[MAX_THREADS];
+    mutex _orphans_lock;            // Only taken on thread exit and by scans
+    vector<Retired> _orphans;       // Retired by threads that have exited
+
+    HazardPointers()
+    {
+        for (int i = 0; i < MAX_THREADS; i++)
+        {
+            _records[i].in_use.store(false, memory_order_relaxed);
+            for (int slot = 0; slot < SLOTS_PER_THREAD; slot++)
+            {
+                _records[i].hazards[slot].store(nullptr, memory_order_relaxed);
+            }
+        }
+    }
+
+    // Everything is quiet by the time statics are destroyed
+    ~HazardPointers()
+    {
+        for (const Retired &node : _orphans)
+        {
+            node.deleter(node.pointer);
+        }
+    }
+
+    ThreadState &threadState()
+    {
+        static thread_local ThreadState state;
+        if (state.record == nullptr)
+        {
+            state.record = claimRecord();
+        }
+        return state;
+    }
+
+    Record *claimRecord()
+    {
+        for (int i = 0; i < MAX_THREADS; i++)
+        {
+            bool expected = false;
+            if (!_records[i].in_use.load(memory_order_relaxed)
+                && _records[i].in_use.compare_exchange_strong(expected, true))
+            {
+                return &_records[i];
+            }
+        }
+        throw length_error("Too many threads using hazard pointers.");
+    }
+
+    void releaseThread(ThreadState &state)
+    {
+        for (int slot = 0; slot < SLOTS_PER_THREAD; slot++)
+        {
+            state.record->hazards[slot].store(nullptr, memory_order_release);
+        }
+        scan(state.retired);
+        if (!state.retired.empty())
+        {
+            lock_guard<mutex> guard(_orphans_lock);
+            _orphans.insert(_orphans.end(), state.retired.begin(), state.retired.end());
+        }
+        state.retired.clear();
+        state.record->in_use.store(false, memory_order_release);
+        state.record = nullptr;
+    }
+
+    // Frees every node in retired that no thread currently protects
+    void scan(vector<Retired> &retired)
+    {
+        // Pick up nodes left behind by exited threads when nobody else is
+        if (_orphans_lock.try_lock())
+        {
+            retired.insert(retired.end(), _orphans.begin(), _orphans.end());
+            _orphans.clear();
+            _orphans_lock.unlock();
+        }
+
+        vector<void *> protected_nodes;
+        for (int i = 0; i < MAX_THREADS; i++)
+        {
+            for (int slot = 0; slot < SLOTS_PER_THREAD; slot++)
+            {
+                void *hazard = _records[i].hazards[slot].load(memory_order_seq_cst);
+                if (hazard != nullptr)
+                {
+                    protected_nodes.push_back(hazard);
+                }
+            }
+        }
+        sort(protected_nodes.begin(), protected_nodes.end());
+
+        vector<Retired> keep;
+        for (const Retired &node : retired)
+        {
+            if (binary_search(protected_nodes.begin(), protected_nodes.end(), node.pointer))
+            {
+                keep.push_back(node);
+            }
+            else
+            {
+                node.deleter(node.pointer);
+            }
+        }
+        retired.swap(keep);
+    }
+
+public:
+
+    HazardPointers(const HazardPointers &other) = delete;
+    HazardPointers &operator=(const HazardPointers &other) = delete;
+
+    static HazardPointers &instance()
+    {
+        static HazardPointers domain;
+        return domain;
+    }
+
+    // Publishes source's current value in hazard slot and returns it.
+    //  Re-reads source until the value is stable, so the returned node
+    //  cannot have been retired before the hazard became visible.
+    template <typename N>
+    N *protect(int slot, const atomic<N *> &source)
+    {
+        atomic<void *> &hazard = threadState().record->hazards[slot];
+        N *node = source.load(memory_order_acquire);
+        while (true)
+        {
+            hazard.store(node, memory_order_seq_cst);
+            N *again = source.load(memory_order_seq_cst);
+            if (again == node)
+            {
+                return node;
+            }
+            node = again;
+        }
+    }
+
+    // Publishes pointer in hazard slot.  The caller must re-check that
+    //  pointer is still reachable before relying on it.
+    void setHazard(int slot, void *pointer)
+    {
+        threadState().record->hazards[slot].store(pointer, memory_order_seq_cst);
+    }
+
+    void clear(int slot)
+    {
+        threadState().record->hazards[slot].store(nullptr, memory_order_release);
+    }
+
+    // Hands node over for deletion once no hazard slot holds it
+    template <typename N>
+    void retire(N *node)
+    {
+        ThreadState &state = threadState();
+        Retired entry;
+        entry.pointer = node;
+        entry.deleter = [](void *pointer) { delete static_cast<N *>(pointer); };
+        state.retired.push_back(entry);
+        if ((int)state.retired.size() >= SCAN_THRESHOLD)
+        {
+            scan(state.retired);
+        }
+    }
+
+    // Frees what this thread has retired and nobody protects any more
+    void reclaim()
+    {
+        scan(threadState().retired);
+    }
+};
+
+#endif
@@ -0,0 +1,681 @@
+/*
+ * IndexLinkedList.h - Singly linked list kept in one contiguous buffer
+ *
+ *  Nodes are slots of a single growable array, and each slot links to the
+ *  next one by its 32-bit index instead of a pointer.  A slot is just the
+ *  item plus that index: no vtable, no 8-byte pointer and no heap block of
+ *  its own, so a list of ints takes 8 bytes per item where a LinkedList
+ *  takes a 24-byte ListNode plus the allocator's header.  Slots freed by
+ *  removals go on a free list, linked through the same next field, and are
+ *  reused by the next insert before the buffer grows.
+ *
+ *  Growing doubles the buffer and moves the items over at the same
+ *  indices, so links never need fixing up.  Copies keep the slot layout
+ *  too (a single memcpy for trivially copyable items) and moves steal the
+ *  buffer.  Appends fill the buffer in order, which is what makes a walk
+ *  over the list a walk through memory; after many inserts and removals in
+ *  the middle, compact() puts the slots back in list order.
+ *
+ */
+
+#ifndef INDEX_LINKED_LIST_H
+#define INDEX_LINKED_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Indexed.h"
+#include "RawStorage.h"
+#include "AllocationStats.h"
+
+using namespace std;
+
+// One slot of an IndexLinkedList.  value is only constructed while the
+//  slot is part of the list; next links to the next slot either way.
+template <typename T>
+struct IndexListSlot
+{
+    typename aligned_storage<sizeof(T), alignof(T)>::type storage;
+    uint32_t next;
+
+    T &value()
+    {
+        return *reinterpret_cast<T *>(&storage);
+    }
+
+    const T &value() const
+    {
+        return *reinterpret_cast<const T *>(&storage);
+    }
+};
+
+// Forward iterator following the links of an IndexLinkedList
+template <typename T, bool IsConst>
+class IndexListIterator
+{
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename conditional<IsConst, const T *, T *>::type pointer;
+    typedef typename conditional<IsConst, const T &, T &>::type reference;
+    typedef typename conditional<IsConst, const IndexListSlot<T>,
+                                 IndexListSlot<T> >::type slot_type;
+
+    static const uint32_t NONE = UINT32_MAX;
+
+private:
+    slot_type *_slots;
+    uint32_t _index;            // Slot we point at, NONE is end()
+
+public:
+
+    IndexListIterator(slot_type *slots = nullptr, uint32_t index = NONE)
+        : _slots(slots), _index(index)
+    {
+    }
+
+    template <bool OtherConst,
+              typename = typename enable_if<IsConst && !OtherConst>::type>
+    IndexListIterator(const IndexListIterator<T, OtherConst> &other)
+        : _slots(other.getSlots()), _index(other.getIndex())
+    {
+    }
+
+    slot_type *getSlots() const
+    {
+        return _slots;
+    }
+
+    uint32_t getIndex() const
+    {
+        return _index;
+    }
+
+    reference operator*() const
+    {
+        return _slots[_index].value();
+    }
+
+    pointer operator->() const
+    {
+        return &_slots[_index].value();
+    }
+
+    IndexListIterator<T, IsConst> &operator++()
+    {
+        _index = _slots[_index].next;
+        return *this;
+    }
+
+    IndexListIterator<T, IsConst> operator++(int)
+    {
+        IndexListIterator<T, IsConst> previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    bool operator==(const IndexListIterator<T, IsConst> &other) const
+    {
+        return _index == other._index;
+    }
+
+    bool operator!=(const IndexListIterator<T, IsConst> &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+
+template <typename T>
+class IndexLinkedList : public Indexed<T>
+{
+//*****************************************************************************
+private:
+    typedef IndexListSlot<T> Slot;
+
+    static const uint32_t NONE = UINT32_MAX;    // "No slot": end of a chain
+    static const int MIN_CAPACITY = 4;
+
+    Slot *_slots = nullptr;                 // The buffer every node lives in
+    int _capacity = 0;                      // Slots in the buffer
+    int _used = 0;                          // Slots [0, _used) have been handed out
+    uint32_t _free = NONE;                  // Head of the free slot list
+    uint32_t _front = NONE;                 // First node
+    uint32_t _end = NONE;                   // Last node, for O(1) appends
+    int _size = 0;
+
+    int _last_accessed_index = 0;           // Cursor for sequential lookups
+    uint32_t _last_accessed_slot = NONE;
+
+    AllocationStats _stats;                 // Allocation counters (see AllocationStats.h)
+
+    // Buffer allocation, counted in our allocation stats
+    Slot *allocateSlots(int capacity)
+    {
+        Slot *slots = RawStorage<Slot>::allocate(capacity);
+        if (slots != nullptr)
+        {
+            CONTAINER_STATS_RECORD(_stats.allocated((long long)sizeof(Slot) * capacity, 0,
+                                                    (long long)(sizeof(Slot) - sizeof(T)) * capacity));
+        }
+        return slots;
+    }
+
+    void releaseSlots(Slot *slots, int capacity)
+    {
+        if (slots != nullptr)
+        {
+            RawStorage<Slot>::release(slots);
+            CONTAINER_STATS_RECORD(_stats.freed((long long)sizeof(Slot) * capacity, 0,
+                                                (long long)(sizeof(Slot) - sizeof(T)) * capacity));
+        }
+    }
+
+    // Builds the first used slots of from into the raw slots to, at the
+    //  same indices: every link, plus a copy (or, if moving, a moved copy)
+    //  of each live value on the chain starting at front
+    static void transferSlots(Slot *from, int used, uint32_t front, Slot *to, bool moving)
+    {
+        if (used == 0)
+        {
+            return;
+        }
+        if (is_trivially_copyable<T>::value)
+        {
+            memcpy(static_cast<void *>(to), from, sizeof(Slot) * (size_t)used);
+            return;
+        }
+        for (int i = 0; i < used; i++)
+        {
+            to[i].next = from[i].next;
+        }
+        uint32_t done = front;
+        try
+        {
+            for (; done != NONE; done = from[done].next)
+            {
+                if (moving)
+                {
+                    new (&to[done].storage) T(std::move_if_noexcept(from[done].value()));
+                }
+                else
+                {
+                    new (&to[done].storage) T(static_cast<const T &>(from[done].value()));
+                }
+            }
+        }
+        catch (...)
+        {
+            for (uint32_t i = front; i != done; i = from[i].next)
+            {
+                to[i].value().~T();
+            }
+            throw;
+        }
+    }
+
+    // Moves every node into a buffer of new_capacity slots
+    void reallocate(int new_capacity)
+    {
+        Slot *slots = allocateSlots(new_capacity);
+        try
+        {
+            transferSlots(_slots, _used, _front, slots, true);
+        }
+        catch (...)
+        {
+            releaseSlots(slots, new_capacity);
+            throw;
+        }
+        destroyValues();
+        releaseSlots(_slots, _capacity);
+        _slots = slots;
+        _capacity = new_capacity;
+    }
+
+    void destroyValues()
+    {
+        if (!is_trivially_destructible<T>::value)
+        {
+            for (uint32_t i = _front; i != NONE; i = _slots[i].next)
+            {
+                _slots[i].value().~T();
+            }
+        }
+    }
+
+    // True when takeSlot() can hand out a slot without growing
+    bool hasFreeSlot() const
+    {
+        return _free != NONE || _used < _capacity;
+    }
+
+    // A slot for a new node: recycled if possible, else the next unused one.
+    //  Grows the buffer when both run out.
+    uint32_t takeSlot()
+    {
+        if (_free != NONE)
+        {
+            uint32_t slot = _free;
+            _free = _slots[slot].next;
+            return slot;
+        }
+        if (_used == _capacity)
+        {
+            reallocate(_capacity * 2 < MIN_CAPACITY ? MIN_CAPACITY : _capacity * 2);
+        }
+        return (uint32_t)_used++;
+    }
+
+    void giveBackSlot(uint32_t slot)
+    {
+        _slots[slot].next = _free;
+        _free = slot;
+    }
+
+    // Slot of the node at index, which must be in range.  Sequential
+    //  lookups continue from the last node we found.
+    uint32_t slotAtIndex(int index) const
+    {
+        uint32_t current = _front;
+        int position = 0;
+        if (index == _size - 1)
+        {
+            return _end;
+        }
+        if (_last_accessed_slot != NONE && index >= _last_accessed_index)
+        {
+            current = _last_accessed_slot;
+            position = _last_accessed_index;
+        }
+        for (; position < index; position++)
+        {
+            current = _slots[current].next;
+        }
+        return current;
+    }
+
+    // Links slot in so that it ends up at index
+    void linkSlot(uint32_t slot, int index)
+    {
+        if (index == 0)
+        {
+            _slots[slot].next = _front;
+            _front = slot;
+            if (_end == NONE)
+            {
+                _end = slot;
+            }
+        }
+        else
+        {
+            uint32_t before = index == _size ? _end : slotAtIndex(index - 1);
+            _slots[slot].next = _slots[before].next;
+            _slots[before].next = slot;
+            if (before == _end)
+            {
+                _end = slot;
+            }
+        }
+        _size++;
+    }
+
+    // Builds a node from args in a slot of its own and links it in at
+    //  index.  If the value's constructor throws, the slot is given back.
+    template <typename... Args>
+    void constructAt(int index, Args &&... args)
+    {
+        uint32_t slot = takeSlot();
+        try
+        {
+            new (&_slots[slot].storage) T(std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            giveBackSlot(slot);
+            throw;
+        }
+        linkSlot(slot, index);
+    }
+
+    void forgetLastAccessed()
+    {
+        _last_accessed_index = 0;
+        _last_accessed_slot = NONE;
+    }
+
+    void checkIndex(int index) const
+    {
+        if (index < 0 || index >= _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+    }
+
+    void stealFrom(IndexLinkedList<T> &other)
+    {
+        _slots = other._slots;
+        _capacity = other._capacity;
+        _used = other._used;
+        _free = other._free;
+        _front = other._front;
+        _end = other._end;
+        _size = other._size;
+        CONTAINER_STATS_RECORD(_stats.takeLive(other._stats));
+        other._slots = nullptr;
+        other._capacity = 0;
+        other._used = 0;
+        other._free = NONE;
+        other._front = NONE;
+        other._end = NONE;
+        other._size = 0;
+        other.forgetLastAccessed();
+    }
+
+//*****************************************************************************
+public:
+    typedef IndexListIterator<T, false> iterator;
+    typedef IndexListIterator<T, true> const_iterator;
+
+    IndexLinkedList()
+    {
+    }
+
+    // Same slot layout as other, in a buffer just big enough for it
+    IndexLinkedList(const IndexLinkedList<T> &other)
+    {
+        if (other._used == 0)
+        {
+            CONTAINER_STATS_RECORD(_stats.copied());
+            return;
+        }
+        _slots = allocateSlots(other._used);
+        try
+        {
+            transferSlots(other._slots, other._used, other._front, _slots, false);
+        }
+        catch (...)
+        {
+            releaseSlots(_slots, other._used);
+            throw;
+        }
+        _capacity = other._used;
+        _used = other._used;
+        _free = other._free;
+        _front = other._front;
+        _end = other._end;
+        _size = other._size;
+        CONTAINER_STATS_RECORD(_stats.copied());
+    }
+
+    IndexLinkedList(IndexLinkedList<T> &&other)
+    {
+        stealFrom(other);
+        CONTAINER_STATS_RECORD(_stats.moved());
+    }
+
+    IndexLinkedList(initializer_list<T> values)
+    {
+        reserve((int)values.size());
+        for (const T &item : values)
+        {
+            addElement(item);
+        }
+    }
+
+    virtual ~IndexLinkedList()
+    {
+        clear();
+    }
+
+    virtual IndexLinkedList<T> &operator=(const IndexLinkedList<T> &other)
+    {
+        if (this != &other)
+        {
+            IndexLinkedList<T> copy{ other };
+            clear();
+            stealFrom(copy);
+            CONTAINER_STATS_RECORD(_stats.copied());
+        }
+        return *this;
+    }
+
+    virtual IndexLinkedList<T> &operator=(IndexLinkedList<T> &&other)
+    {
+        if (this != &other)
+        {
+            clear();
+            stealFrom(other);
+            CONTAINER_STATS_RECORD(_stats.moved());
+        }
+        return *this;
+    }
+
+    // Destroys every item and frees the buffer
+    void clear()
+    {
+        destroyValues();
+        releaseSlots(_slots, _capacity);
+        _slots = nullptr;
+        _capacity = 0;
+        _used = 0;
+        _free = NONE;
+        _front = NONE;
+        _end = NONE;
+        _size = 0;
+        forgetLastAccessed();
+    }
+
+    virtual bool isEmpty() const final
+    {
+        return _size == 0;
+    }
+
+    virtual int getSize() const final
+    {
+        return _size;
+    }
+
+    // Slots in the buffer, used or not
+    int capacity() const
+    {
+        return _capacity;
+    }
+
+    // Makes room for at least new_capacity nodes.  Never shrinks.
+    void reserve(int new_capacity)
+    {
+        if (new_capacity > _capacity)
+        {
+            reallocate(new_capacity);
+        }
+    }
+
+    // Rebuilds the buffer with the nodes in list order and no free slots,
+    //  so walking the list reads the buffer front to back
+    void compact()
+    {
+        Slot *slots = allocateSlots(_size);
+        uint32_t done = _front;
+        uint32_t position = 0;
+        try
+        {
+            for (; done != NONE; done = _slots[done].next, position++)
+            {
+                new (&slots[position].storage) T(std::move_if_noexcept(_slots[done].value()));
+                slots[position].next = position + 1;
+            }
+        }
+        catch (...)
+        {
+            for (uint32_t i = 0; i < position; i++)
+            {
+                slots[i].value().~T();
+            }
+            releaseSlots(slots, _size);
+            throw;
+        }
+        int count = _size;
+        destroyValues();
+        releaseSlots(_slots, _capacity);
+        _slots = slots;
+        _capacity = count;
+        _used = count;
+        _free = NONE;
+        _front = count > 0 ? 0 : NONE;
+        _end = count > 0 ? (uint32_t)(count - 1) : NONE;
+        if (count > 0)
+        {
+            _slots[_end].next = NONE;
+        }
+        forgetLastAccessed();
+    }
+
+    // Allocation counters for this list; all zero unless built with
+    //  CONTAINER_STATS (see AllocationStats.h)
+    AllocationStats getStats() const
+    {
+        return _stats;
+    }
+
+    virtual void addElement(const T &value)
+    {
+        emplaceElementAt(_size, value);
+    }
+
+    virtual void addElement(T &&value)
+    {
+        emplaceElementAt(_size, std::move(value));
+    }
+
+    template <typename... Args>
+    void emplaceElement(Args &&... args)
+    {
+        emplaceElementAt(_size, std::forward<Args>(args)...);
+    }
+
+    virtual T &getElementAt(int index) final
+    {
+        checkIndex(index);
+        uint32_t slot = slotAtIndex(index);
+        _last_accessed_index = index;
+        _last_accessed_slot = slot;
+        return _slots[slot].value();
+    }
+
+    // Note: like LinkedList, the const version cannot move the cursor
+    virtual const T &getElementAt(int index) const final
+    {
+        checkIndex(index);
+        return _slots[slotAtIndex(index)].value();
+    }
+
+    virtual void setElementAt(const T &value, int index) final
+    {
+        getElementAt(index) = value;
+    }
+
+    virtual void setElementAt(T &&value, int index) final
+    {
+        getElementAt(index) = std::move(value);
+    }
+
+    virtual void addElementAt(const T &value, int index)
+    {
+        emplaceElementAt(index, value);
+    }
+
+    virtual void addElementAt(T &&value, int index)
+    {
+        emplaceElementAt(index, std::move(value));
+    }
+
+    // Constructs straight into a free slot.  If the buffer has to grow,
+    //  args may refer to one of our items, so the value is built first.
+    template <typename... Args>
+    void emplaceElementAt(int index, Args &&... args)
+    {
+        if (index < 0 || index > _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+        if (!hasFreeSlot())
+        {
+            T value(std::forward<Args>(args)...);
+            constructAt(index, std::move(value));
+        }
+        else
+        {
+            constructAt(index, std::forward<Args>(args)...);
+        }
+        forgetLastAccessed();
+    }
+
+    virtual void removeElementAt(int index)
+    {
+        checkIndex(index);
+        uint32_t removed;
+        if (index == 0)
+        {
+            removed = _front;
+            _front = _slots[removed].next;
+            if (_front == NONE)
+            {
+                _end = NONE;
+            }
+        }
+        else
+        {
+            uint32_t before = slotAtIndex(index - 1);
+            removed = _slots[before].next;
+            _slots[before].next = _slots[removed].next;
+            if (removed == _end)
+            {
+                _end = before;
+            }
+        }
+        _slots[removed].value().~T();
+        giveBackSlot(removed);
+        _size--;
+        forgetLastAccessed();
+    }
+
+    iterator begin()
+    {
+        return iterator(_slots, _front);
+    }
+
+    iterator end()
+    {
+        return iterator(_slots, NONE);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_slots, _front);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(_slots, NONE);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+#endif
@@ -7,18 +7,31 @@
 #ifndef INDEXED_H
 #define INDEXED_H
 
+#include <utility>
 #include "Collection.h"
 
-//Indexed ADTs allow items to be inserted at specific locations within a Collection
+//Indexed ADTs allow items to be inserted at specific locations within a Collection.
+//Containers mark their size and element accessors final, so calls made on
+//the concrete type skip the vtable; see StaticIndexed.h.
 template <typename T>
 class Indexed : public Collection<T>
 {
 public:
 	virtual T &getElementAt(int index) = 0;
 	virtual const T& getElementAt(int location) const = 0;
-	virtual void setElementAt(T item, int index) = 0;
-	virtual void addElementAt(T item, int index) = 0;
+	virtual void setElementAt(const T &item, int index) = 0;
+	virtual void setElementAt(T &&item, int index) = 0;
+	virtual void addElementAt(const T &item, int index) = 0;
+	virtual void addElementAt(T &&item, int index) = 0;
 	virtual void removeElementAt(int index) = 0;
+
+	//builds an item from args at index; see Collection::emplaceElement.
+	//The index comes first since args is a variadic pack.
+	template <typename... Args>
+	void emplaceElementAt(int index, Args &&... args)
+	{
+		addElementAt(T(std::forward<Args>(args)...), index);
+	}
 };
 
 #endif
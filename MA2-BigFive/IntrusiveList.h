@@ -0,0 +1,437 @@
+/*
+ * IntrusiveList.h - Doubly linked list threaded through its own items
+ *
+ *  LinkedList copies every item into a node it allocates.  Objects that
+ *  already live somewhere else (connection or session records, say) can
+ *  instead derive from IntrusiveListHook and be linked in place: the hook
+ *  holds the prev/next pointers, so adding and removing never allocates or
+ *  copies, and an item can be removed in O(1) from just a reference to it.
+ *
+ *  An item can sit in several lists at once by deriving from one hook per
+ *  list, told apart by a tag type:
+ *
+ *      struct ByAge;
+ *      struct ByIdle;
+ *      struct Session : IntrusiveListHook<ByAge>, IntrusiveListHook<ByIdle>
+ *      { ... };
+ *      IntrusiveList<Session, ByAge> oldest_first;
+ *      IntrusiveList<Session, ByIdle> idle_first;
+ *
+ *  The list never owns its items.  They must outlive their membership, and
+ *  clearing or destroying a list just unlinks them.  Lists can be moved but
+ *  not copied; copying an item gives the copy unlinked hooks.
+ *
+ *  Every hook also remembers which list it is in, so moving a list walks
+ *  its items to update them.  In safe mode that lets adding an item that
+ *  is already linked, or removing one through the wrong list, throw
+ *  logic_error.  Safe mode is on unless NDEBUG is defined; building with
+ *  -DINTRUSIVE_SAFE_MODE=0 or =1 picks it explicitly.  Only the checks
+ *  depend on it, never the hook's layout, so translation units built in
+ *  different modes still agree on the size of every item.  Destroying an
+ *  item that is still linked fails an assert.
+ *
+ */
+
+#ifndef INTRUSIVE_LIST_H
+#define INTRUSIVE_LIST_H
+
+#include <cassert>
+#include <cstddef>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+
+using namespace std;
+
+#ifndef INTRUSIVE_SAFE_MODE
+#ifdef NDEBUG
+#define INTRUSIVE_SAFE_MODE 0
+#else
+#define INTRUSIVE_SAFE_MODE 1
+#endif
+#endif
+
+#if INTRUSIVE_SAFE_MODE
+#define INTRUSIVE_CHECK(condition, message) \
+    do { if (!(condition)) { throw logic_error(message); } } while (0)
+#else
+#define INTRUSIVE_CHECK(condition, message) ((void)0)
+#endif
+
+template <typename T, typename Tag>
+class IntrusiveList;
+
+template <typename T, typename Tag, bool IsConst>
+class IntrusiveListIterator;
+
+// Links an item into one IntrusiveList<T, Tag>.  Unlinked hooks have null
+//  links, which is how isLinked() tells.
+template <typename Tag = void>
+class IntrusiveListHook
+{
+    template <typename T, typename ListTag>
+    friend class IntrusiveList;
+
+    template <typename T, typename ListTag, bool IsConst>
+    friend class IntrusiveListIterator;
+
+    IntrusiveListHook<Tag> *_prev = nullptr;
+    IntrusiveListHook<Tag> *_next = nullptr;
+    const void *_owner = nullptr;           // List we are in
+
+public:
+
+    IntrusiveListHook()
+    {
+    }
+
+    // Links belong to the item, not its value: copies start out unlinked
+    //  and assignment leaves our links alone
+    IntrusiveListHook(const IntrusiveListHook<Tag> &)
+    {
+    }
+
+    IntrusiveListHook<Tag> &operator=(const IntrusiveListHook<Tag> &)
+    {
+        return *this;
+    }
+
+    ~IntrusiveListHook()
+    {
+        assert(!isLinked() && "Item destroyed while still in an IntrusiveList");
+    }
+
+    bool isLinked() const
+    {
+        return _next != nullptr;
+    }
+};
+
+// Bidirectional iterator over the items of an IntrusiveList
+template <typename T, typename Tag, bool IsConst>
+class IntrusiveListIterator
+{
+public:
+    typedef bidirectional_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename conditional<IsConst, const T *, T *>::type pointer;
+    typedef typename conditional<IsConst, const T &, T &>::type reference;
+    typedef typename conditional<IsConst, const IntrusiveListHook<Tag>,
+                                 IntrusiveListHook<Tag> >::type hook_type;
+
+private:
+    hook_type *_hook;
+
+public:
+
+    explicit IntrusiveListIterator(hook_type *hook = nullptr) : _hook(hook)
+    {
+    }
+
+    template <bool OtherConst,
+              typename = typename enable_if<IsConst && !OtherConst>::type>
+    IntrusiveListIterator(const IntrusiveListIterator<T, Tag, OtherConst> &other)
+        : _hook(other.getHook())
+    {
+    }
+
+    hook_type *getHook() const
+    {
+        return _hook;
+    }
+
+    reference operator*() const
+    {
+        return static_cast<reference>(*_hook);
+    }
+
+    pointer operator->() const
+    {
+        return &**this;
+    }
+
+    IntrusiveListIterator<T, Tag, IsConst> &operator++()
+    {
+        _hook = _hook->_next;
+        return *this;
+    }
+
+    IntrusiveListIterator<T, Tag, IsConst> operator++(int)
+    {
+        IntrusiveListIterator<T, Tag, IsConst> previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    IntrusiveListIterator<T, Tag, IsConst> &operator--()
+    {
+        _hook = _hook->_prev;
+        return *this;
+    }
+
+    IntrusiveListIterator<T, Tag, IsConst> operator--(int)
+    {
+        IntrusiveListIterator<T, Tag, IsConst> previous = *this;
+        --(*this);
+        return previous;
+    }
+
+    bool operator==(const IntrusiveListIterator<T, Tag, IsConst> &other) const
+    {
+        return _hook == other._hook;
+    }
+
+    bool operator!=(const IntrusiveListIterator<T, Tag, IsConst> &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+
+template <typename T, typename Tag = void>
+class IntrusiveList
+{
+//*****************************************************************************
+private:
+    typedef IntrusiveListHook<Tag> Hook;
+
+    // The chain is circular through _root, which is not an item: the first
+    //  item's _prev and the last item's _next point at it
+    Hook _root;
+    int _size = 0;
+
+    static Hook &hookOf(T &item)
+    {
+        return static_cast<Hook &>(item);
+    }
+
+    void makeEmpty()
+    {
+        _root._next = &_root;
+        _root._prev = &_root;
+        _size = 0;
+    }
+
+    void checkInList(const Hook &hook) const
+    {
+        INTRUSIVE_CHECK(hook._owner == this, "Item is not in this list.");
+    }
+
+    void checkNotEmpty() const
+    {
+        if (_size == 0)
+        {
+            throw out_of_range("List is empty.");
+        }
+    }
+
+    // Links hook in just before next
+    void linkBefore(Hook &next, Hook &hook)
+    {
+        INTRUSIVE_CHECK(!hook.isLinked(), "Item is already in a list.");
+        hook._prev = next._prev;
+        hook._next = &next;
+        next._prev->_next = &hook;
+        next._prev = &hook;
+        hook._owner = this;
+        _size++;
+    }
+
+    void unlink(Hook &hook)
+    {
+        hook._prev->_next = hook._next;
+        hook._next->_prev = hook._prev;
+        hook._prev = nullptr;
+        hook._next = nullptr;
+        hook._owner = nullptr;
+        _size--;
+    }
+
+    // Takes other's chain; we must be empty
+    void stealFrom(IntrusiveList<T, Tag> &other)
+    {
+        if (other._size == 0)
+        {
+            return;
+        }
+        _root._next = other._root._next;
+        _root._prev = other._root._prev;
+        _root._next->_prev = &_root;
+        _root._prev->_next = &_root;
+        _size = other._size;
+        other.makeEmpty();
+        for (Hook *hook = _root._next; hook != &_root; hook = hook->_next)
+        {
+            hook->_owner = this;
+        }
+    }
+
+//*****************************************************************************
+public:
+    typedef IntrusiveListIterator<T, Tag, false> iterator;
+    typedef IntrusiveListIterator<T, Tag, true> const_iterator;
+
+    IntrusiveList()
+    {
+        static_assert(is_base_of<Hook, T>::value,
+                      "T must derive from IntrusiveListHook<Tag>.");
+        makeEmpty();
+    }
+
+    // Items can only be in one list per hook, so there is nothing to copy into
+    IntrusiveList(const IntrusiveList<T, Tag> &other) = delete;
+    IntrusiveList<T, Tag> &operator=(const IntrusiveList<T, Tag> &other) = delete;
+
+    IntrusiveList(IntrusiveList<T, Tag> &&other)
+    {
+        makeEmpty();
+        stealFrom(other);
+    }
+
+    // Unlinks whatever is left; the items themselves are not ours
+    ~IntrusiveList()
+    {
+        clear();
+        _root._next = nullptr;
+        _root._prev = nullptr;
+    }
+
+    IntrusiveList<T, Tag> &operator=(IntrusiveList<T, Tag> &&other)
+    {
+        if (this != &other)
+        {
+            clear();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    // Unlinks every item, leaving it free to join another list
+    void clear()
+    {
+        Hook *hook = _root._next;
+        while (hook != &_root)
+        {
+            Hook *next = hook->_next;
+            hook->_prev = nullptr;
+            hook->_next = nullptr;
+            hook->_owner = nullptr;
+            hook = next;
+        }
+        makeEmpty();
+    }
+
+    bool isEmpty() const
+    {
+        return _size == 0;
+    }
+
+    int getSize() const
+    {
+        return _size;
+    }
+
+    void addFront(T &item)
+    {
+        linkBefore(*_root._next, hookOf(item));
+    }
+
+    void addBack(T &item)
+    {
+        linkBefore(_root, hookOf(item));
+    }
+
+    // Links item in just before position, which must be in this list
+    void addBefore(T &position, T &item)
+    {
+        checkInList(hookOf(position));
+        linkBefore(hookOf(position), hookOf(item));
+    }
+
+    // O(1): the item's own hook knows its neighbours
+    void remove(T &item)
+    {
+        checkInList(hookOf(item));
+        unlink(hookOf(item));
+    }
+
+    T &removeFront()
+    {
+        checkNotEmpty();
+        T &item = static_cast<T &>(*_root._next);
+        unlink(*_root._next);
+        return item;
+    }
+
+    T &removeBack()
+    {
+        checkNotEmpty();
+        T &item = static_cast<T &>(*_root._prev);
+        unlink(*_root._prev);
+        return item;
+    }
+
+    T &getFront()
+    {
+        checkNotEmpty();
+        return static_cast<T &>(*_root._next);
+    }
+
+    const T &getFront() const
+    {
+        checkNotEmpty();
+        return static_cast<const T &>(*_root._next);
+    }
+
+    T &getBack()
+    {
+        checkNotEmpty();
+        return static_cast<T &>(*_root._prev);
+    }
+
+    const T &getBack() const
+    {
+        checkNotEmpty();
+        return static_cast<const T &>(*_root._prev);
+    }
+
+    // Iterator at item, which must be in this list
+    iterator iteratorTo(T &item)
+    {
+        checkInList(hookOf(item));
+        return iterator(&hookOf(item));
+    }
+
+    iterator begin()
+    {
+        return iterator(_root._next);
+    }
+
+    iterator end()
+    {
+        return iterator(&_root);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_root._next);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(&_root);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+#endif
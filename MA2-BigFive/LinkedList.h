@@ -17,10 +17,12 @@
 #include <stdexcept>
 #include <initializer_list>
 #include <utility>
-#include <iostream>
 
 #include "Indexed.h"
 #include "ListNode.h"
+#include "ListIterator.h"
+#include "Trace.h"
+#include "AllocationStats.h"
 
 using namespace std;
 
@@ -42,7 +44,7 @@ private:
     int _last_accessed_index = 0;               // Tracking accesses for some functions
     ListNode<T> *_last_accessed_node = nullptr; // Tracking last accessed node for copies
 
-    bool _debug = false;                        // debug_on() debug_off() - cout output control
+    AllocationStats _stats;                     // Allocation counters (see AllocationStats.h)
 
 //*****************************************************************************
 protected:
@@ -52,16 +54,91 @@ protected:
         return _end;
     }
 
-    // Creates a new node (effectively a Factory interface)
-    virtual ListNode<T> *createNode(T value)
+    // Creates a new node (effectively a Factory interface).  The rvalue
+    //  version moves the value into the node instead of copying it.
+    virtual ListNode<T> *createNode(const T &value)
     {
-        return new ListNode < T > { value };
+        ListNode<T> *node = new ListNode < T > { value };
+        countNodeCreated();
+        return node;
+    }
+
+    virtual ListNode<T> *createNode(T &&value)
+    {
+        ListNode<T> *node = new ListNode < T > { std::move(value) };
+        countNodeCreated();
+        return node;
     }
 
     // Wrapped method to properly delete a passed in node
     virtual void deleteNode(ListNode<T> *node)
     {
         delete node;
+        countNodeDeleted();
+    }
+
+    // Allocation counting (see AllocationStats.h); overrides of createNode
+    //  and deleteNode call these too
+    void countNodeCreated()
+    {
+        CONTAINER_STATS_RECORD(_stats.allocated(sizeof(ListNode<T>), 1, sizeof(ListNode<T>) - sizeof(T)));
+    }
+
+    void countNodeDeleted()
+    {
+        CONTAINER_STATS_RECORD(_stats.freed(sizeof(ListNode<T>), 1, sizeof(ListNode<T>) - sizeof(T)));
+    }
+
+    void countCopied()
+    {
+        CONTAINER_STATS_RECORD(_stats.copied());
+    }
+
+    void countMoved()
+    {
+        CONTAINER_STATS_RECORD(_stats.moved());
+    }
+
+    // True when our nodes come from createNode's plain new.  PooledLinkedList
+    //  carves them out of its own pool instead, and such nodes can neither
+    //  be deleted by nor handed over to a list that doesn't own that pool.
+    virtual bool ownsHeapNodes() const
+    {
+        return true;
+    }
+
+    // Takes other's whole chain; we must be empty.  Only for lists that
+    //  allocate nodes the same way (see takeNodes).
+    void stealNodes(LinkedList<T> &other)
+    {
+        _front = other._front;
+        _end = other._end;
+        _size = other._size;
+        _last_accessed_index = other._last_accessed_index;
+        _last_accessed_node = other._last_accessed_node;
+        CONTAINER_STATS_RECORD(_stats.takeLive(other._stats));
+        other._front = nullptr;
+        other._end = nullptr;
+        other._size = 0;
+        other._last_accessed_index = 0;
+        other._last_accessed_node = nullptr;
+    }
+
+    // Moves other's contents to us; we must be empty.  Heap nodes change
+    //  hands as they are, otherwise the values are moved into nodes of our
+    //  own and other's nodes are freed by other.
+    void takeNodes(LinkedList<T> &other)
+    {
+        if (ownsHeapNodes() && other.ownsHeapNodes())
+        {
+            stealNodes(other);
+            return;
+        }
+        for (ListNode<T> *node = other._front; node != nullptr; node = node->getNext())
+        {
+            appendNode(std::move(node->getValue()));
+        }
+        other.clear();
     }
 
     // Can be used to return a ListNode<T> at a specific index.
@@ -136,6 +213,129 @@ protected:
         return current;
     }
 
+    // Links a new node holding value after _end, skipping addElementAt's
+    //  index bookkeeping
+    void appendNode(const T &value)
+    {
+        linkAtEnd(createNode(value));
+    }
+
+    void appendNode(T &&value)
+    {
+        linkAtEnd(createNode(std::move(value)));
+    }
+
+    void linkAtEnd(ListNode<T> *node)
+    {
+        if (_end == nullptr)
+        {
+            _front = node;
+        }
+        else
+        {
+            _end->setNext(node);
+        }
+        _end = node;
+        _size++;
+    }
+
+    // Links new_value into the list so that it ends up at location
+    void linkNode(ListNode<T> *new_value, int location)
+    {
+        // When adding to a LL, we have to consider three possibilities:
+        //  Option #1: are we adding this to the front
+        if (location == 0)
+        {
+            new_value->setNext(_front);
+            _front = new_value;
+        }
+        else if (location == _size)
+        {
+            // Option #2: Adding to the end of the list
+            _end->setNext(new_value);
+            _end = _end->getNext();
+        }
+        else
+        {
+            // Option #3: Adding somewhere else
+            ListNode<T> *before = getNodeAtIndex(location - 1);
+            new_value->setNext(before->getNext());
+            before->setNext(new_value);
+        }
+
+        if (_size == 0)      // Is size 0? -> set end to front
+        {
+            _end = _front;
+        }
+
+        _size++;             // Remember to increment size counter
+    }
+
+    // Insert positions run from 0 through size (appending); checked before
+    //  a node is created so a bad index cannot leak one
+    void checkInsert(int location) const
+    {
+        if (location < 0 || location > _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+    }
+
+    // The cached cursor may point at a node that is about to go away
+    void forgetLastAccessed()
+    {
+        _last_accessed_index = 0;
+        _last_accessed_node = nullptr;
+    }
+
+    // Merges the sorted run left..left_last with the run first..last that
+    //  came after it; first and last are updated to the merged run.  Ties
+    //  go to left, which is what keeps sort() stable.
+    template <typename Compare>
+    static void mergeRuns(ListNode<T> *left, ListNode<T> *left_last,
+                          ListNode<T> *&first, ListNode<T> *&last, Compare &less)
+    {
+        ListNode<T> *right = first;
+        if (less(right->getValue(), left->getValue()))
+        {
+            first = right;
+            right = right->getNext();
+        }
+        else
+        {
+            first = left;
+            left = left->getNext();
+        }
+
+        ListNode<T> *tail = first;
+        while (left != nullptr && right != nullptr)
+        {
+            if (less(right->getValue(), left->getValue()))
+            {
+                tail->setNext(right);
+                tail = right;
+                right = right->getNext();
+            }
+            else
+            {
+                tail->setNext(left);
+                tail = left;
+                left = left->getNext();
+            }
+        }
+
+        // Whatever is left of one run is already in order
+        if (left != nullptr)
+        {
+            tail->setNext(left);
+            last = left_last;
+        }
+        else
+        {
+            tail->setNext(right);
+        }
+    }
+
 
 //*****************************************************************************
 public:
@@ -146,7 +346,6 @@ public:
     {
         _front = nullptr;
         _end = _front;
-        _debug = false;     // Default is no detailed out - see debug_on()
     }
 
 //***************************************************************************//
@@ -156,26 +355,13 @@ public:
     //  MA TODO: Implement!
     LinkedList(const LinkedList<T> &other)
     {
-        if(_debug)
-            { cout << " [x] Copy Constructor executed. " << endl;}
-      // Copy every element in other to ourselves 
-    if (this != &other)
-    { 
-           if (_front != nullptr)
-       {
-             for(int i = 0; i < _size;i++)
-             {
-                removeElementAt(i);
-             }
-       }
-           for (int i = 0;i < other.getSize(); i++)
-           { 
-             T item = other.getElementAt(i);
-             addElementAt(item, i);
-           }
-        }         
-
-
+        // Copy every element in other to ourselves in one walk of its chain
+        for (const ListNode<T> *node = other._front; node != nullptr; node = node->getNext())
+        {
+            appendNode(node->getValue());
+        }
+        CONTAINER_TRACE_EVENT(TraceEvent::COPY_CONSTRUCT, this, _size);
+        CONTAINER_STATS_RECORD(_stats.copied());
     }
 
 
@@ -183,26 +369,12 @@ public:
     //  MA TODO: Implement!
     LinkedList(LinkedList<T> &&other)
     {
-        if(_debug)
-            { cout << " [x] Move Constructor executed. " << endl; }
-        // Copy the pointers within other to ourselves
-
-    _front = other._front;
-    _end = other._end;
-
-        //  Also copy their class varibles (_last_accessed_index, etc)
-        _size = other._size;
-        _last_accessed_index = other._last_accessed_index;
-    _last_accessed_node = other._last_accessed_node;
-    _debug = other._debug;
-        // Reset pointers in other to nullptr
-
-    other._front = nullptr;
-    other._end = nullptr;
-    other._size = 0;
-    other._last_accessed_index = 0;
-    other._last_accessed_node = nullptr;
-    _debug = false;
+        // Take other's nodes (or, for a pooled list, its values) and leave
+        //  it empty.  In here ownsHeapNodes() is always ours, so only other
+        //  decides; PooledLinkedList doesn't come through here.
+        takeNodes(other);
+        CONTAINER_TRACE_EVENT(TraceEvent::MOVE_CONSTRUCT, this, _size);
+        CONTAINER_STATS_RECORD(_stats.moved());
     }
 
 
@@ -210,12 +382,12 @@ public:
     //  MA TODO: Implement!
     LinkedList(initializer_list<T> values)
     {
-        cout << " [x] Initializer List Constructor executed. " << endl;
         // Add a copy of every element in values to ourselves
-    for (auto item : values)
-    {
-       addElement(item);
-    }
+        for (const T &item : values)
+        {
+            appendNode(item);
+        }
+        CONTAINER_TRACE_EVENT(TraceEvent::INITIALIZER_LIST_CONSTRUCT, this, _size);
     }
 
 
@@ -223,14 +395,9 @@ public:
     //  MA TODO: Implement!
     virtual ~LinkedList()
     {
-        if( _debug ){ 
-            cout << "  [x] LinkedList Destructor executed. " << endl;
-        }
+        CONTAINER_TRACE_EVENT(TraceEvent::DESTRUCT, this, _size);
         // Delete every node in our internal linked list
-    while(getSize() > 0)
-    {
-        removeElementAt(0);
-    }
+        clear();
     }
 
     // Copy assignment operator
@@ -238,24 +405,55 @@ public:
     virtual LinkedList<T> &operator=(const LinkedList<T> &other)
     {
         // Note: might want to make sure we don't copy ourselves!
-        cout << " [x] Copy *assignment* operator called. " << endl;
-
-        // Delete our elements
-    
-    if (this != &other)
-    { 
-       while( getSize() > 0 )
-       {
-              removeElementAt(0);
-       }
-        // Add in copies of other's elements
-
-           for (int i = 0;i < other.getSize(); i++)
-           { 
-             T item = other.getElementAt(i);
-             addElement(item);
-           }
-        }         
+        if (this == &other)
+        {
+            return *this;
+        }
+
+        // Reuse the nodes we already have: overwrite values in place, then
+        //  allocate or free only the difference in length
+        int matched = 0;
+        ListNode<T> *last = nullptr;
+        ListNode<T> *mine = _front;
+        const ListNode<T> *theirs = other._front;
+        while (mine != nullptr && theirs != nullptr)
+        {
+            mine->setValue(theirs->getValue());
+            last = mine;
+            mine = mine->getNext();
+            theirs = theirs->getNext();
+            matched++;
+        }
+
+        // We were longer: cut the chain after last and free the rest
+        if (mine != nullptr)
+        {
+            if (last == nullptr)
+            {
+                _front = nullptr;
+            }
+            else
+            {
+                last->setNext(nullptr);
+            }
+            _end = last;
+            while (mine != nullptr)
+            {
+                ListNode<T> *next = mine->getNext();
+                deleteNode(mine);
+                mine = next;
+            }
+        }
+        _size = matched;
+        forgetLastAccessed();
+
+        // Other was longer: append the remaining values
+        for (; theirs != nullptr; theirs = theirs->getNext())
+        {
+            appendNode(theirs->getValue());
+        }
+        CONTAINER_TRACE_EVENT(TraceEvent::COPY_ASSIGN, this, _size);
+        CONTAINER_STATS_RECORD(_stats.copied());
         return *this;
     }
 
@@ -264,32 +462,18 @@ public:
     //  MA TODO: Implement!
     virtual LinkedList<T> &operator=(LinkedList<T> &&other)
     {
-
-        cout << " [x] Move *assignment* operator called. " << endl;
-        // Delete our own elements
-
-        if (_front != nullptr)
+        // Never move into ourselves
+        if (this == &other)
         {
-            for(int i = 0; i < _size;i++)
-            {
-               deleteNode(getNodeAtIndex(i)); 
-            }
+            return *this;
         }
-        // Grab other data for ourselves
-
 
-    _front = other._front;
-    _end = other._end;
-    _size = other._size;
-    _last_accessed_index = other._last_accessed_index;
-    _last_accessed_node = other._last_accessed_node;
-        // Reset their pointers to nullptr
-
-    other._front = nullptr;
-    other._end = nullptr;
-    other._size = 0;
-    other._last_accessed_index = 0;
-    other._last_accessed_node = nullptr;
+        // Delete our own elements
+        clear();
+        // Grab other data for ourselves, and reset theirs
+        takeNodes(other);
+        CONTAINER_TRACE_EVENT(TraceEvent::MOVE_ASSIGN, this, _size);
+        CONTAINER_STATS_RECORD(_stats.moved());
         return *this;
     }
 
@@ -297,11 +481,97 @@ public:
 // End Microassignment zone
 //***************************************************************************//
 
-    // Interfaces to set debugging
+    // Interfaces to set debugging.  Tracing is now chosen at compile time
+    //  (see Trace.h), so these are kept only so existing callers build.
     void debug_off()
-        { _debug = false; }
+        { }
     void debug_on()
-        { _debug = true; }
+        { }
+
+    // Removes every element in one pass down the chain
+    void clear()
+    {
+        ListNode<T> *current = _front;
+        while (current != nullptr)
+        {
+            ListNode<T> *next = current->getNext();
+            deleteNode(current);
+            current = next;
+        }
+        _front = nullptr;
+        _end = nullptr;
+        _size = 0;
+        forgetLastAccessed();
+    }
+
+    // Stable sort into ascending order by operator<
+    void sort()
+    {
+        sort([](const T &left, const T &right) { return left < right; });
+    }
+
+    // Stable sort where less(a, b) is true when a belongs before b.
+    //  Bottom-up merge sort that relinks _next pointers only: nothing is
+    //  allocated and no value is copied.  Nodes are taken one at a time
+    //  and merged into runs[level], which holds a sorted run of 2^level
+    //  nodes, like carrying in binary addition.  Merges stay among recently
+    //  touched nodes, so far fewer cache misses than whole-list passes.
+    template <typename Compare>
+    void sort(Compare less)
+    {
+        if (_size < 2)
+        {
+            return;
+        }
+
+        // Values stay in their nodes, but the node at each index changes
+        forgetLastAccessed();
+
+        // Runs at higher levels hold earlier nodes; _size < 2^31
+        const int LEVELS = 32;
+        ListNode<T> *firsts[LEVELS] = {};
+        ListNode<T> *lasts[LEVELS] = {};
+
+        ListNode<T> *node = _front;
+        while (node != nullptr)
+        {
+            ListNode<T> *first = node;
+            ListNode<T> *last = node;
+            node = node->getNext();
+            last->setNext(nullptr);
+
+            int level = 0;
+            for (; firsts[level] != nullptr; level++)
+            {
+                mergeRuns(firsts[level], lasts[level], first, last, less);
+                firsts[level] = nullptr;
+            }
+            firsts[level] = first;
+            lasts[level] = last;
+        }
+
+        // Fold what's left, newest (lowest) runs first
+        ListNode<T> *first = nullptr;
+        ListNode<T> *last = nullptr;
+        for (int level = 0; level < LEVELS; level++)
+        {
+            if (firsts[level] == nullptr)
+            {
+                continue;
+            }
+            if (first == nullptr)
+            {
+                first = firsts[level];
+                last = lasts[level];
+            }
+            else
+            {
+                mergeRuns(firsts[level], lasts[level], first, last, less);
+            }
+        }
+        _front = first;
+        _end = last;
+    }
 
     // Returns pointer to front of list - THIS IS DANGEROUS
     // Should be protected:, but I need it here for testing the destructor
@@ -311,27 +581,73 @@ public:
         return _front;
     }
 
+    // Allocation counters for this list; all zero unless built with
+    //  CONTAINER_STATS (see AllocationStats.h)
+    AllocationStats getStats() const
+    {
+        return _stats;
+    }
+
+    // STL-style iteration: for (auto &value : list) and <algorithm>
+    typedef ListIterator<T, false> iterator;
+    typedef ListIterator<T, true> const_iterator;
+
+    iterator begin()
+    {
+        return iterator(_front);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_front);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+
     // Will return true if the LL is empty.
-    virtual bool isEmpty() const
+    virtual bool isEmpty() const final
     {
         return _size == 0;
     }
 
     // Returns the size of the LL.
-    virtual int getSize() const
+    virtual int getSize() const final
     {
         return _size;
     }
 
     // Appends the supplied item to the end of our LL
-    virtual void addElement(T value)
+    virtual void addElement(const T &value)
     {
         addElementAt(value, getSize());
     }
 
+    virtual void addElement(T &&value)
+    {
+        addElementAt(std::move(value), getSize());
+    }
+
 
     // Returns the value at the specified index
-    virtual T& getElementAt(int location)
+    virtual T& getElementAt(int location) final
     {
         //explicit way
         //ListNode<T> *result = getNodeAtIndex(location);
@@ -346,55 +662,40 @@ public:
 
 
     // Returns a reference to the element at a given index/location
-    virtual const T &getElementAt(int location) const
+    virtual const T &getElementAt(int location) const final
     {
         return getNodeAtIndex(location)->getValue();
     }
 
 
     // Sets the value at the specified index
-    virtual void setElementAt(T value, int location)
+    virtual void setElementAt(const T &value, int location) final
     {
         getNodeAtIndex(location)->setValue(value);
     }
 
+    virtual void setElementAt(T &&value, int location) final
+    {
+        getNodeAtIndex(location)->setValue(std::move(value));
+    }
+
 
     // Inserts the specified value in a new Node at the specified index and 
     //  shifts everything else to the "right" by one.
-    virtual void addElementAt(T value, int location)
+    //  Note: emplaceElement/emplaceElementAt come from Indexed and move a
+    //  temporary in, since createNode is a virtual hook and can't forward
+    //  constructor arguments.
+    virtual void addElementAt(const T &value, int location)
     {
-        ListNode<T> *new_value = createNode(value);
-
-        // When adding to a LL, we have to consider three possibilities:
-        //  Option #1: are we adding this to the front
-        if (location == 0)
-        {
-            new_value->setNext(_front);
-            _front = new_value;
-        }
-        else if (location == _size)
-        {
-            // Option #2: Adding to the end of the list
-            _end->setNext(new_value);
-            _end = _end->getNext();
-        }
-        else
-        {
-            // Option #3: Adding somewhere else
-            ListNode<T> *before = getNodeAtIndex(location - 1);
-            new_value->setNext(before->getNext());
-            before->setNext(new_value);
-        }
-
-        if (_size == 0)      // Is size 0? -> set end to front
-        {
-            _end = _front;
-        }
-
-        _size++;             // Remember to increment size counter
-
+        checkInsert(location);
+        linkNode(createNode(value), location);
     }
 
+    virtual void addElementAt(T &&value, int location)
+    {
+        checkInsert(location);
+        linkNode(createNode(std::move(value)), location);
+    }
 
     // Removes the element at the specified index.
     virtual void removeElementAt(int index)
@@ -0,0 +1,90 @@
+/*
+ * ListIterator.h - STL-style forward iterator over a chain of ListNodes
+ *
+ *  Walks the _next pointers directly, so range-for loops and <algorithm>
+ *  calls over a LinkedList skip the bounds checks and cursor bookkeeping of
+ *  getElementAt.
+ *
+ */
+
+#ifndef LIST_ITERATOR_H
+#define LIST_ITERATOR_H
+
+#include <cstddef>
+#include <iterator>
+#include <type_traits>
+
+#include "ListNode.h"
+
+using namespace std;
+
+// IsConst selects between iterator (false) and const_iterator (true)
+template <typename T, bool IsConst>
+class ListIterator
+{
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename conditional<IsConst, const T *, T *>::type pointer;
+    typedef typename conditional<IsConst, const T &, T &>::type reference;
+    typedef typename conditional<IsConst, const ListNode<T>, ListNode<T> >::type node_type;
+
+private:
+    node_type *_node;           // Node we point at, nullptr is end()
+
+public:
+
+    ListIterator(node_type *node = nullptr) : _node(node)
+    {
+    }
+
+    // Lets a plain iterator turn into a const_iterator (never the reverse)
+    template <bool OtherConst,
+              typename = typename enable_if<IsConst && !OtherConst>::type>
+    ListIterator(const ListIterator<T, OtherConst> &other) : _node(other.getNode())
+    {
+    }
+
+    node_type *getNode() const
+    {
+        return _node;
+    }
+
+    reference operator*() const
+    {
+        return _node->getValue();
+    }
+
+    pointer operator->() const
+    {
+        return &_node->getValue();
+    }
+
+    // Pre-increment: ++it
+    ListIterator<T, IsConst> &operator++()
+    {
+        _node = _node->getNext();
+        return *this;
+    }
+
+    // Post-increment: it++
+    ListIterator<T, IsConst> operator++(int)
+    {
+        ListIterator<T, IsConst> previous = *this;
+        _node = _node->getNext();
+        return previous;
+    }
+
+    bool operator==(const ListIterator<T, IsConst> &other) const
+    {
+        return _node == other._node;
+    }
+
+    bool operator!=(const ListIterator<T, IsConst> &other) const
+    {
+        return _node != other._node;
+    }
+};
+
+#endif
@@ -9,6 +9,10 @@
 #ifndef LIST_NODE_H
 #define LIST_NODE_H
 
+#include <utility>
+
+#include "Collection.h"
+
 // A list node represents a single "box" inside a lined list.  In this 
 //  scheme, the LinkedList is simply a collection of ListNode boxes.
 template <typename T>
@@ -28,6 +32,19 @@ public:
 		_next = nullptr;
 	}
 
+	// Takes over a temporary value without copying it
+	ListNode(T &&value) : _value(std::move(value))
+	{
+		_next = nullptr;
+	}
+
+	// Builds the value in place from args
+	template <typename... Args>
+	ListNode(EmplaceTag, Args &&... args) : _value(std::forward<Args>(args)...)
+	{
+		_next = nullptr;
+	}
+
     // Basic empty ListNode Constructor
 	ListNode()
 	{
@@ -56,7 +73,6 @@ public:
     // Destructor
 	virtual ~ListNode()
 	{
-		_value = 0;
 		_next = nullptr;
 	}
 
@@ -89,6 +105,11 @@ public:
 	{
 		_value = value;
 	}
+
+	void setValue(T &&value)
+	{
+		_value = std::move(value);
+	}
 };
 
 #endif
@@ -0,0 +1,384 @@
+/*
+ * MappedArray.h - An Array whose items live in a memory-mapped file
+ *
+ *  The file is an ArrayFileHeader followed by the items (see ArrayFile.h),
+ *  and the whole file is mapped with mmap.  Opening a file only maps it:
+ *  nothing is read or parsed, and pages are loaded by the kernel as the
+ *  items are first touched.  Hence T must be trivially copyable.
+ *
+ *  A read-write array maps the file shared, so the items are the file.  A
+ *  full array grows the file (doubling, like Vector) and maps it again,
+ *  which moves the items: pointers and references into a MappedArray are
+ *  invalidated by growth just as they are for a Vector.  The item count in
+ *  the header is brought up to date by sync(), which also flushes the
+ *  mapping to disk (msync) and is the point at which the contents are
+ *  durable, and on close.  Closing also trims spare capacity off the end.
+ *
+ *  A read-only array maps the file privately.  Any number of processes can
+ *  map the same file this way and share its pages.  The items can still be
+ *  changed in memory like those of any Array, but those changes are never
+ *  written back, and the array cannot grow past the items in the file.
+ *
+ */
+
+#ifndef MAPPED_ARRAY_H
+#define MAPPED_ARRAY_H
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include "Array.h"
+#include "ArrayFile.h"
+using namespace std;
+
+enum MappedAccess
+{
+	MAPPED_READ_ONLY,
+	MAPPED_READ_WRITE
+};
+
+template <typename T>
+class MappedArray : public Array<T>
+{
+	static_assert(is_trivially_copyable<T>::value,
+		"MappedArray items are stored as raw bytes and must be trivially copyable.");
+	static_assert(alignof(T) <= sizeof(ArrayFileHeader),
+		"MappedArray items may not be aligned past the file header.");
+
+protected:
+
+	//smallest capacity we grow to from an empty file
+	static const int MIN_CAPACITY = 4;
+
+	string _path;
+	MappedAccess _access;
+	int _file = -1;
+
+	//the whole file, header first
+	char *_map = nullptr;
+	size_t _map_bytes = 0;
+
+	//the mapping is not ours to free with operator delete
+	virtual bool ownsHeapItems() const
+	{
+		return false;
+	}
+
+	//throws for a failed system call, with errno's description
+	void fail(const string &what) const
+	{
+		throw runtime_error(what + " " + _path + ": " + strerror(errno));
+	}
+
+	ArrayFileHeader *header()
+	{
+		return reinterpret_cast<ArrayFileHeader *>(_map);
+	}
+
+	static size_t fileBytes(int capacity)
+	{
+		return sizeof(ArrayFileHeader) + sizeof(T) * (size_t)capacity;
+	}
+
+	//maps the first bytes of the file and points _items just past the header
+	void mapFile(size_t bytes)
+	{
+		int sharing = _access == MAPPED_READ_ONLY ? MAP_PRIVATE : MAP_SHARED;
+		void *map = mmap(nullptr, bytes, PROT_READ | PROT_WRITE, sharing, _file, 0);
+		if (map == MAP_FAILED)
+		{
+			fail("Could not map");
+		}
+		_map = static_cast<char *>(map);
+		_map_bytes = bytes;
+		this->_items = reinterpret_cast<T *>(_map + sizeof(ArrayFileHeader));
+		this->_max_size = (int)((bytes - sizeof(ArrayFileHeader)) / sizeof(T));
+	}
+
+	void unmapFile()
+	{
+		if (_map != nullptr)
+		{
+			munmap(_map, _map_bytes);
+		}
+		_map = nullptr;
+		_map_bytes = 0;
+		this->_items = nullptr;
+		this->_max_size = 0;
+	}
+
+	//sets the file's size to hold capacity items and maps it again.  The
+	//items stay in the file, so only their address changes.
+	void resizeFile(int capacity)
+	{
+		if (_access == MAPPED_READ_ONLY)
+		{
+			throw logic_error("MappedArray is read-only.");
+		}
+		if (ftruncate(_file, (off_t)fileBytes(capacity)) != 0)
+		{
+			fail("Could not resize");
+		}
+		unmapFile();
+		mapFile(fileBytes(capacity));
+	}
+
+	void grow()
+	{
+		int new_capacity = this->_max_size * 2;
+		if (new_capacity < MIN_CAPACITY)
+		{
+			new_capacity = MIN_CAPACITY;
+		}
+		resizeFile(new_capacity);
+	}
+
+	//opens (or, for read-write, creates) _path and maps it
+	void openFile()
+	{
+		int flags = _access == MAPPED_READ_ONLY ? O_RDONLY : O_RDWR | O_CREAT;
+		_file = open(_path.c_str(), flags, 0644);
+		if (_file < 0)
+		{
+			fail("Could not open");
+		}
+		struct stat status;
+		if (fstat(_file, &status) != 0)
+		{
+			fail("Could not stat");
+		}
+
+		size_t bytes = (size_t)status.st_size;
+		if (bytes == 0 && _access == MAPPED_READ_WRITE)
+		{
+			resizeFile(0);
+			*header() = arrayFileHeader<T>(0);
+			return;
+		}
+		if (bytes < sizeof(ArrayFileHeader))
+		{
+			throw runtime_error(_path + " is not an array file.");
+		}
+
+		mapFile(bytes);
+		checkArrayFileHeader<T>(*header(), _path);
+		if (header()->item_count > (uint64_t)this->_max_size)
+		{
+			throw runtime_error(_path + " is shorter than its header says.");
+		}
+		this->_number_of_items = (int)header()->item_count;
+	}
+
+	//records the item count, trims spare capacity and lets go of the file
+	void closeFile()
+	{
+		if (_map != nullptr && _access == MAPPED_READ_WRITE)
+		{
+			header()->item_count = (uint64_t)this->_number_of_items;
+			int count = this->_number_of_items;
+			unmapFile();
+			//a failed trim only leaves spare capacity in the file
+			int trimmed = ftruncate(_file, (off_t)fileBytes(count));
+			(void)trimmed;
+		}
+		unmapFile();
+		if (_file >= 0)
+		{
+			close(_file);
+		}
+		_file = -1;
+		this->_number_of_items = 0;
+	}
+
+	//takes over other's file, leaving it closed; we must hold none
+	void takeFile(MappedArray<T> &other)
+	{
+		_path = std::move(other._path);
+		_access = other._access;
+		_file = other._file;
+		_map = other._map;
+		_map_bytes = other._map_bytes;
+		this->_items = other._items;
+		this->_max_size = other._max_size;
+		this->_number_of_items = other._number_of_items;
+		other._file = -1;
+		other._map = nullptr;
+		other._map_bytes = 0;
+		other._items = nullptr;
+		other._max_size = 0;
+		other._number_of_items = 0;
+	}
+
+public:
+
+#pragma region constructors / destructors
+
+	//opens the array stored at path.  A read-write array creates an empty
+	//file if there is none.  Throws runtime_error if the file can't be
+	//opened or wasn't written for items of T's size.
+	MappedArray(const string &path, MappedAccess access = MAPPED_READ_WRITE)
+		: Array<T>(0), _path(path), _access(access)
+	{
+		try
+		{
+			openFile();
+		}
+		catch (...)
+		{
+			//leave a file we couldn't read exactly as we found it
+			unmapFile();
+			if (_file >= 0)
+			{
+				close(_file);
+			}
+			throw;
+		}
+	}
+
+	//two arrays writing one mapping would fight over its size
+	MappedArray(const MappedArray<T> &other) = delete;
+
+	MappedArray(MappedArray<T> &&other)
+		: Array<T>(0), _access(other._access)
+	{
+		takeFile(other);
+	}
+
+	//~Array must not see the mapping, which would try to free it
+	virtual ~MappedArray()
+	{
+		closeFile();
+	}
+
+#pragma endregion
+
+#pragma region Indexed overrides
+
+	//same as Array::addElementAt, except a full read-write array grows
+	virtual void addElementAt(const T &value, int location)
+	{
+		addElementAt(T(value), location);
+	}
+
+	virtual void addElementAt(T &&value, int location)
+	{
+		if (location < 0 || location > this->_number_of_items)
+		{
+			throw out_of_range("MappedArray index out of bounds.");
+		}
+		if (this->_number_of_items == this->_max_size && _access == MAPPED_READ_WRITE)
+		{
+			//value may be one of our items, which growing moves
+			T item = value;
+			grow();
+			Array<T>::addElementAt(std::move(item), location);
+			return;
+		}
+		Array<T>::addElementAt(std::move(value), location);
+	}
+
+#pragma endregion
+
+#pragma region MappedArray-specific functions
+
+	const string &path() const
+	{
+		return _path;
+	}
+
+	bool isReadOnly() const
+	{
+		return _access == MAPPED_READ_ONLY;
+	}
+
+	//number of items the file has room for before it has to grow
+	int capacity() const
+	{
+		return this->_max_size;
+	}
+
+	//grows the file to hold at least new_capacity items.  Never shrinks.
+	//Throws logic_error for a read-only array.
+	void reserve(int new_capacity)
+	{
+		if (new_capacity > this->_max_size)
+		{
+			resizeFile(new_capacity);
+		}
+	}
+
+	//trims the file down to the items it holds
+	void shrink_to_fit()
+	{
+		if (this->_max_size > this->_number_of_items)
+		{
+			resizeFile(this->_number_of_items);
+		}
+	}
+
+	//writes the item count to the header and blocks until the file is on
+	//disk.  Throws logic_error for a read-only array.
+	void sync()
+	{
+		if (_access == MAPPED_READ_ONLY)
+		{
+			throw logic_error("MappedArray is read-only.");
+		}
+		header()->item_count = (uint64_t)this->_number_of_items;
+		if (msync(_map, _map_bytes, MS_SYNC) != 0)
+		{
+			fail("Could not sync");
+		}
+	}
+
+#pragma endregion
+
+#pragma region operator overloads
+
+	MappedArray<T> &operator=(const MappedArray<T> &other)
+	{
+		MappedArray<T>::operator=(static_cast<const Array<T> &>(other));
+		return *this;
+	}
+
+	//closes our file (see the destructor) and takes over other's
+	MappedArray<T> &operator=(MappedArray<T> &&other)
+	{
+		if (this != &other)
+		{
+			closeFile();
+			takeFile(other);
+		}
+		return *this;
+	}
+
+	//replaces our items with a copy of other's, growing the file if needed
+	virtual Array<T> &operator=(const Array<T> &other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		reserve(other.getSize());
+		RawStorage<T>::copyConstruct(this->_items, other.begin(), other.getSize());
+		this->_number_of_items = other.getSize();
+		return *this;
+	}
+
+	//items are plain bytes, so moving one in is copying it; other keeps
+	//its items
+	virtual Array<T> &operator=(Array<T> &&other)
+	{
+		return MappedArray<T>::operator=(static_cast<const Array<T> &>(other));
+	}
+
+#pragma endregion
+};
+
+#endif
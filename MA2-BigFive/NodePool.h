@@ -0,0 +1,175 @@
+/*
+ * NodePool.h - Slab allocator for LinkedList nodes
+ *
+ *  Hands out ListNode<T> objects from large contiguous blocks instead of
+ *  going through the global new/delete for every single node.  Freed nodes
+ *  are kept on an intrusive free list and recycled by the next allocation.
+ *  All blocks are released together when the pool is destroyed.
+ *
+ */
+
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ListNode.h"
+
+using namespace std;
+
+template <typename T>
+class NodePool
+{
+public:
+    static const int DEFAULT_BLOCK_SIZE = 256;  // Nodes per slab
+
+private:
+    // A slot is raw storage for one node.  While the slot is free, its
+    //  first bytes are reused as the link to the next free slot.
+    union Slot
+    {
+        Slot *next_free;
+        typename aligned_storage<sizeof(ListNode<T>),
+                                 alignof(ListNode<T>)>::type storage;
+    };
+
+    vector<Slot *> _blocks;         // Every slab we have allocated
+    Slot *_free_list = nullptr;     // Recycled slots, most recent first
+    int _block_size;                // Number of slots in each slab
+    int _next_unused;               // Bump index into the newest slab
+    int _live_nodes = 0;            // Nodes currently handed out
+
+    // Returns an unused slot: recycled if possible, otherwise bumped from
+    //  the newest slab, otherwise from a freshly allocated slab.
+    Slot *takeSlot()
+    {
+        if (_free_list != nullptr)
+        {
+            Slot *slot = _free_list;
+            _free_list = slot->next_free;
+            return slot;
+        }
+        if (_next_unused == _block_size)
+        {
+            _blocks.push_back(new Slot[_block_size]);
+            _next_unused = 0;
+        }
+        return &_blocks.back()[_next_unused++];
+    }
+
+    void releaseBlocks()
+    {
+        for (Slot *block : _blocks)
+        {
+            delete[] block;
+        }
+        _blocks.clear();
+        _free_list = nullptr;
+        _next_unused = _block_size;
+        _live_nodes = 0;
+    }
+
+public:
+
+    NodePool(int block_size = DEFAULT_BLOCK_SIZE)
+    {
+        if (block_size < 1)
+        {
+            throw invalid_argument("Block size must be positive.");
+        }
+        _block_size = block_size;
+        _next_unused = _block_size;     // Forces a slab on first allocation
+    }
+
+    // Pools own raw memory that nodes point into - no copies allowed
+    NodePool(const NodePool<T> &other) = delete;
+    NodePool<T> &operator=(const NodePool<T> &other) = delete;
+
+    // Move constructor steals every slab from other
+    NodePool(NodePool<T> &&other)
+        : _blocks(std::move(other._blocks)),
+          _free_list(other._free_list),
+          _block_size(other._block_size),
+          _next_unused(other._next_unused),
+          _live_nodes(other._live_nodes)
+    {
+        other._blocks.clear();
+        other._free_list = nullptr;
+        other._next_unused = other._block_size;
+        other._live_nodes = 0;
+    }
+
+    // Releases every slab at once.  Any nodes still handed out must not be
+    //  used afterwards; their destructors are NOT run.
+    ~NodePool()
+    {
+        releaseBlocks();
+    }
+
+    // Exchanges all slabs with other.  Nodes keep their addresses.
+    void swap(NodePool<T> &other)
+    {
+        std::swap(_blocks, other._blocks);
+        std::swap(_free_list, other._free_list);
+        std::swap(_block_size, other._block_size);
+        std::swap(_next_unused, other._next_unused);
+        std::swap(_live_nodes, other._live_nodes);
+    }
+
+    // Builds a node inside pool storage whose value is constructed from
+    //  args (a value to copy or move, or any constructor arguments)
+    template <typename... Args>
+    ListNode<T> *allocate(Args &&... args)
+    {
+        Slot *slot = takeSlot();
+        ListNode<T> *node = nullptr;
+        try
+        {
+            node = new (&slot->storage) ListNode<T>(EmplaceTag(), std::forward<Args>(args)...);
+        }
+        catch (...)
+        {
+            // A throwing constructor must not cost us the slot
+            slot->next_free = _free_list;
+            _free_list = slot;
+            throw;
+        }
+        _live_nodes++;
+        return node;
+    }
+
+    // Destroys a node from this pool and recycles its slot
+    void deallocate(ListNode<T> *node)
+    {
+        if (node == nullptr)
+        {
+            return;
+        }
+        node->~ListNode<T>();
+        Slot *slot = reinterpret_cast<Slot *>(node);
+        slot->next_free = _free_list;
+        _free_list = slot;
+        _live_nodes--;
+    }
+
+    int getBlockSize() const
+    {
+        return _block_size;
+    }
+
+    int getBlockCount() const
+    {
+        return (int)_blocks.size();
+    }
+
+    int getLiveNodes() const
+    {
+        return _live_nodes;
+    }
+};
+
+#endif
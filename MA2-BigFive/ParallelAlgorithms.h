@@ -0,0 +1,397 @@
+/*
+ * ParallelAlgorithms.h - Parallel for-each, transform and reduce
+ *
+ *  The algorithms work on any contiguous storage: a pair of pointers, or
+ *  a container whose begin()/end() are plain pointers (Array, Vector).
+ *  They skip getElementAt entirely and walk the raw items.
+ *
+ *  The range is cut into chunks that the calling thread and the workers
+ *  of a ThreadPool claim one at a time, so a thread that finishes early
+ *  simply takes more chunks.  ParallelOptions tunes the split:
+ *
+ *    - chunk_size: items per chunk.  0 picks a size from the range and
+ *      the pool, aiming at several chunks per thread.
+ *    - deterministic: parallelReduce combines per-chunk results in chunk
+ *      order, with a chunk size that doesn't depend on the pool, so a
+ *      floating point sum comes out bit-for-bit the same on any machine.
+ *      Otherwise each thread folds its chunks as it goes and the results
+ *      are combined in whatever order the threads finish.
+ *    - pool: the ThreadPool to use; nullptr means ThreadPool::instance().
+ *
+ *  The functions passed in are called from several threads at once.  If
+ *  one throws, the chunks nobody has started are skipped and the first
+ *  exception is rethrown to the caller.
+ *
+ */
+
+#ifndef PARALLEL_ALGORITHMS_H
+#define PARALLEL_ALGORITHMS_H
+
+#include <algorithm>
+#include <atomic>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+#include "ThreadPool.h"
+
+using namespace std;
+
+struct ParallelOptions
+{
+    static const int MIN_CHUNK = 2048;              // Smallest automatic chunk
+    static const int CHUNKS_PER_THREAD = 8;         // Slack for load balancing
+    static const int DETERMINISTIC_CHUNK = 16384;
+
+    int chunk_size = 0;
+    bool deterministic = false;
+    ThreadPool *pool = nullptr;
+};
+
+// Hands out the chunks of [0, count) to whoever asks next
+class ParallelChunks
+{
+private:
+    atomic<long long> _next;
+    long long _count;
+    long long _chunk_size;
+    long long _chunks;
+
+public:
+
+    ParallelChunks(long long count, long long chunk_size)
+        : _next(0), _count(count), _chunk_size(chunk_size),
+          _chunks((count + chunk_size - 1) / chunk_size)
+    {
+    }
+
+    long long getChunkCount() const
+    {
+        return _chunks;
+    }
+
+    // Claims the next chunk.  Returns false when none are left.
+    bool claim(long long &chunk, long long &begin, long long &end)
+    {
+        chunk = _next.fetch_add(1, memory_order_relaxed);
+        if (chunk >= _chunks)
+        {
+            return false;
+        }
+        begin = chunk * _chunk_size;
+        end = min(begin + _chunk_size, _count);
+        return true;
+    }
+
+    // Makes every later claim fail
+    void cancel()
+    {
+        _next.store(_chunks, memory_order_relaxed);
+    }
+};
+
+// Tracks the pool workers helping with one parallel call.  A worker that
+//  picks up its task after the caller has closed the gate leaves without
+//  touching the caller's (by then possibly gone) stack.
+class ParallelGate
+{
+private:
+    static const int CLOSED = 1 << 30;
+
+    atomic<int> _state;             // CLOSED bit plus workers inside
+    mutex _error_lock;
+    exception_ptr _error;
+
+public:
+
+    ParallelGate() : _state(0)
+    {
+    }
+
+    bool enter()
+    {
+        int state = _state.load(memory_order_acquire);
+        while ((state & CLOSED) == 0)
+        {
+            if (_state.compare_exchange_weak(state, state + 1, memory_order_acq_rel))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void leave()
+    {
+        _state.fetch_sub(1, memory_order_acq_rel);
+    }
+
+    void close()
+    {
+        _state.fetch_or(CLOSED, memory_order_acq_rel);
+    }
+
+    // True once closed with nobody left inside
+    bool isDrained() const
+    {
+        return _state.load(memory_order_acquire) == CLOSED;
+    }
+
+    void fail(exception_ptr error)
+    {
+        lock_guard<mutex> guard(_error_lock);
+        if (!_error)
+        {
+            _error = error;
+        }
+    }
+
+    void rethrowIfFailed()
+    {
+        lock_guard<mutex> guard(_error_lock);
+        if (_error)
+        {
+            rethrow_exception(_error);
+        }
+    }
+};
+
+inline ThreadPool &parallelPool(const ParallelOptions &options)
+{
+    return options.pool != nullptr ? *options.pool : ThreadPool::instance();
+}
+
+inline long long parallelChunkSize(long long count, const ParallelOptions &options,
+                                   const ThreadPool &pool)
+{
+    if (options.chunk_size > 0)
+    {
+        return options.chunk_size;
+    }
+    if (options.deterministic)
+    {
+        return ParallelOptions::DETERMINISTIC_CHUNK;
+    }
+    long long size = count / ((long long)pool.getConcurrency() * ParallelOptions::CHUNKS_PER_THREAD);
+    return max(size, (long long)ParallelOptions::MIN_CHUNK);
+}
+
+// Runs work() on the calling thread and on as many pool workers as there
+//  are chunks to share; every run of work() claims chunks until none are
+//  left.  Returns once all of them are done.
+template <typename Work>
+void parallelRun(ThreadPool &pool, ParallelChunks &chunks, Work &work)
+{
+    auto participate = [&chunks, &work]()
+    {
+        try
+        {
+            work();
+        }
+        catch (...)
+        {
+            chunks.cancel();
+            throw;
+        }
+    };
+
+    shared_ptr<ParallelGate> gate = make_shared<ParallelGate>();
+    long long helpers = min(chunks.getChunkCount() - 1, (long long)pool.getWorkerCount());
+    for (long long i = 0; i < helpers; i++)
+    {
+        pool.submit([gate, &participate]()
+        {
+            if (!gate->enter())
+            {
+                return;
+            }
+            try
+            {
+                participate();
+            }
+            catch (...)
+            {
+                gate->fail(current_exception());
+            }
+            gate->leave();
+        });
+    }
+
+    try
+    {
+        participate();
+    }
+    catch (...)
+    {
+        gate->fail(current_exception());
+    }
+
+    // Helpers still inside are finishing their last chunk; lend a hand
+    //  with other queued work meanwhile
+    gate->close();
+    while (!gate->isDrained())
+    {
+        if (!pool.runPendingTask())
+        {
+            this_thread::yield();
+        }
+    }
+    gate->rethrowIfFailed();
+}
+
+// Calls visit(item) on every item of [first, last)
+template <typename T, typename F>
+void parallelForEach(T *first, T *last, F visit,
+                     const ParallelOptions &options = ParallelOptions())
+{
+    ThreadPool &pool = parallelPool(options);
+    long long count = last - first;
+    ParallelChunks chunks(count, parallelChunkSize(count, options, pool));
+    auto work = [&]()
+    {
+        long long chunk, begin, end;
+        while (chunks.claim(chunk, begin, end))
+        {
+            for (long long i = begin; i < end; i++)
+            {
+                visit(first[i]);
+            }
+        }
+    };
+    parallelRun(pool, chunks, work);
+}
+
+// Stores transform(first[i]) in out[i] for every item of [first, last)
+template <typename T, typename U, typename F>
+void parallelTransform(const T *first, const T *last, U *out, F transform,
+                       const ParallelOptions &options = ParallelOptions())
+{
+    ThreadPool &pool = parallelPool(options);
+    long long count = last - first;
+    ParallelChunks chunks(count, parallelChunkSize(count, options, pool));
+    auto work = [&]()
+    {
+        long long chunk, begin, end;
+        while (chunks.claim(chunk, begin, end))
+        {
+            for (long long i = begin; i < end; i++)
+            {
+                out[i] = transform(first[i]);
+            }
+        }
+    };
+    parallelRun(pool, chunks, work);
+}
+
+// Folds every item of [first, last) into init with combine, which must be
+//  associative (and commutative unless options.deterministic is set)
+template <typename T, typename V, typename Op>
+V parallelReduce(const T *first, const T *last, V init, Op combine,
+                 const ParallelOptions &options = ParallelOptions())
+{
+    ThreadPool &pool = parallelPool(options);
+    long long count = last - first;
+    if (count <= 0)
+    {
+        return init;
+    }
+    ParallelChunks chunks(count, parallelChunkSize(count, options, pool));
+
+    if (options.deterministic)
+    {
+        vector<V> partials((size_t)chunks.getChunkCount(), init);
+        auto work = [&]()
+        {
+            long long chunk, begin, end;
+            while (chunks.claim(chunk, begin, end))
+            {
+                V total = first[begin];
+                for (long long i = begin + 1; i < end; i++)
+                {
+                    total = combine(total, first[i]);
+                }
+                partials[(size_t)chunk] = total;
+            }
+        };
+        parallelRun(pool, chunks, work);
+
+        V result = init;
+        for (const V &partial : partials)
+        {
+            result = combine(result, partial);
+        }
+        return result;
+    }
+
+    mutex result_lock;
+    V result = init;
+    auto work = [&]()
+    {
+        long long chunk, begin, end;
+        if (!chunks.claim(chunk, begin, end))
+        {
+            return;
+        }
+        V total = first[begin];
+        long long i = begin + 1;
+        while (true)
+        {
+            for (; i < end; i++)
+            {
+                total = combine(total, first[i]);
+            }
+            if (!chunks.claim(chunk, begin, end))
+            {
+                break;
+            }
+            i = begin;
+        }
+
+        lock_guard<mutex> guard(result_lock);
+        result = combine(result, total);
+    };
+    parallelRun(pool, chunks, work);
+    return result;
+}
+
+// Container versions, for anything whose begin()/end() are plain pointers
+template <typename C>
+struct IsContiguous
+{
+    static const bool value = is_pointer<decltype(declval<C &>().begin())>::value;
+};
+
+template <typename C, typename F>
+void parallelForEach(C &items, F visit, const ParallelOptions &options = ParallelOptions())
+{
+    static_assert(IsContiguous<C>::value, "parallelForEach needs contiguous storage");
+    parallelForEach(items.begin(), items.end(), visit, options);
+}
+
+// out must already hold as many items as in
+template <typename C, typename D, typename F>
+void parallelTransform(const C &in, D &out, F transform,
+                       const ParallelOptions &options = ParallelOptions())
+{
+    static_assert(IsContiguous<const C>::value && IsContiguous<D>::value,
+                  "parallelTransform needs contiguous storage");
+    if (out.getSize() != in.getSize())
+    {
+        throw invalid_argument("Output size does not match input size.");
+    }
+    parallelTransform(in.begin(), in.end(), out.begin(), transform, options);
+}
+
+template <typename C, typename V, typename Op>
+V parallelReduce(const C &items, V init, Op combine,
+                 const ParallelOptions &options = ParallelOptions())
+{
+    static_assert(IsContiguous<const C>::value, "parallelReduce needs contiguous storage");
+    return parallelReduce(items.begin(), items.end(), init, combine, options);
+}
+
+#endif
@@ -0,0 +1,145 @@
+/*
+ * PooledLinkedList.h - LinkedList whose nodes come from a NodePool
+ *
+ *  Plugs a slab allocator into the createNode/deleteNode factory hooks of
+ *  LinkedList.  Each list owns its own pool, so nodes of a list are packed
+ *  into a few contiguous blocks and add/remove churn never touches malloc
+ *  once the pool is warm.
+ *
+ */
+
+#ifndef POOLED_LINKED_LIST_H
+#define POOLED_LINKED_LIST_H
+
+#include <initializer_list>
+#include <utility>
+
+#include "LinkedList.h"
+#include "NodePool.h"
+
+using namespace std;
+
+template <typename T>
+class PooledLinkedList : public LinkedList<T>
+{
+private:
+    NodePool<T> _pool;
+
+protected:
+    virtual ListNode<T> *createNode(const T &value)
+    {
+        ListNode<T> *node = _pool.allocate(value);
+        this->countNodeCreated();
+        return node;
+    }
+
+    virtual ListNode<T> *createNode(T &&value)
+    {
+        ListNode<T> *node = _pool.allocate(std::move(value));
+        this->countNodeCreated();
+        return node;
+    }
+
+    virtual void deleteNode(ListNode<T> *node)
+    {
+        _pool.deallocate(node);
+        this->countNodeDeleted();
+    }
+
+    virtual bool ownsHeapNodes() const
+    {
+        return false;
+    }
+
+    // Appends copies of every value in the node chain starting at node
+    void appendChain(const ListNode<T> *node)
+    {
+        while (node != nullptr)
+        {
+            this->addElement(node->getValue());
+            node = node->getNext();
+        }
+    }
+
+public:
+
+    PooledLinkedList(int nodes_per_block = NodePool<T>::DEFAULT_BLOCK_SIZE)
+        : LinkedList<T>(), _pool(nodes_per_block)
+    {
+    }
+
+    // Note: LinkedList's own copy constructor would run before our
+    //  createNode exists, so we build the copy ourselves
+    PooledLinkedList(const PooledLinkedList<T> &other)
+        : LinkedList<T>(), _pool(other._pool.getBlockSize())
+    {
+        appendChain(other.getFront());
+        this->countCopied();
+    }
+
+    // Nodes stay where they are; the pool that owns them moves with them
+    PooledLinkedList(PooledLinkedList<T> &&other)
+        : LinkedList<T>(), _pool(std::move(other._pool))
+    {
+        this->stealNodes(other);
+        this->countMoved();
+    }
+
+    PooledLinkedList(initializer_list<T> values)
+        : LinkedList<T>(), _pool()
+    {
+        for (auto item : values)
+        {
+            this->addElement(item);
+        }
+    }
+
+    // Must clear before _pool goes away, and while our deleteNode is still
+    //  the one the vtable dispatches to
+    virtual ~PooledLinkedList()
+    {
+        this->clear();
+    }
+
+    PooledLinkedList<T> &operator=(const PooledLinkedList<T> &other)
+    {
+        // Recycles our existing nodes; only the size difference touches
+        //  the pool
+        LinkedList<T>::operator=(other);
+        return *this;
+    }
+
+    PooledLinkedList<T> &operator=(PooledLinkedList<T> &&other)
+    {
+        if (this != &other)
+        {
+            // Our old nodes go back to our pool, then we take other's
+            //  nodes and trade pools so each list owns its nodes' storage
+            this->clear();
+            this->stealNodes(other);
+            _pool.swap(other._pool);
+            this->countMoved();
+        }
+        return *this;
+    }
+
+    // Moves through a LinkedList reference.  Only another pooled list can
+    //  hand over its nodes; a plain list's values are moved into our pool.
+    virtual LinkedList<T> &operator=(LinkedList<T> &&other)
+    {
+        PooledLinkedList<T> *pooled = dynamic_cast<PooledLinkedList<T> *>(&other);
+        if (pooled != nullptr)
+        {
+            return *this = std::move(*pooled);
+        }
+        return LinkedList<T>::operator=(std::move(other));
+    }
+
+    // Exposes the pool for tests and benchmarks
+    const NodePool<T> &getPool() const
+    {
+        return _pool;
+    }
+};
+
+#endif
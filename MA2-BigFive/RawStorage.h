@@ -0,0 +1,203 @@
+/*
+ * RawStorage.h - Uninitialized storage helpers for contiguous containers
+ *
+ *  Memory comes from ::operator new without constructing anything.  Only the
+ *  slots a container actually uses are constructed (placement new) and later
+ *  destroyed explicitly.  This keeps construction cost proportional to the
+ *  number of live items and lets containers hold types that have no default
+ *  constructor.
+ *
+ *  Trivially copyable types skip the per-item loops and are copied or
+ *  shifted as raw bytes with memcpy/memmove; the choice is made at compile
+ *  time.
+ *
+ */
+
+#ifndef RAW_STORAGE_H
+#define RAW_STORAGE_H
+#include <cstddef>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+using namespace std;
+
+template <typename T>
+class RawStorage
+{
+	//::operator new only promises alignment suitable for fundamental types
+	static_assert(alignof(T) <= alignof(max_align_t),
+		"RawStorage does not support over-aligned element types.");
+
+	static void defaultConstruct(T *destination, int count, true_type)
+	{
+		int constructed = 0;
+		try
+		{
+			for (; constructed < count; constructed++)
+			{
+				new (destination + constructed) T();
+			}
+		}
+		catch (...)
+		{
+			destroy(destination, constructed);
+			throw;
+		}
+	}
+
+	static void defaultConstruct(T *, int count, false_type)
+	{
+		if (count > 0)
+		{
+			throw invalid_argument("Type is not default constructible.");
+		}
+	}
+
+	static void copyConstruct(T *destination, const T *source, int count, true_type)
+	{
+		if (count > 0)
+		{
+			memcpy(destination, source, sizeof(T) * (size_t)count);
+		}
+	}
+
+	static void copyConstruct(T *destination, const T *source, int count, false_type)
+	{
+		int constructed = 0;
+		try
+		{
+			for (; constructed < count; constructed++)
+			{
+				new (destination + constructed) T(source[constructed]);
+			}
+		}
+		catch (...)
+		{
+			destroy(destination, constructed);
+			throw;
+		}
+	}
+
+	static void moveConstruct(T *destination, T *source, int count, true_type)
+	{
+		copyConstruct(destination, source, count, true_type());
+	}
+
+	static void moveConstruct(T *destination, T *source, int count, false_type)
+	{
+		int constructed = 0;
+		try
+		{
+			for (; constructed < count; constructed++)
+			{
+				new (destination + constructed) T(std::move_if_noexcept(source[constructed]));
+			}
+		}
+		catch (...)
+		{
+			destroy(destination, constructed);
+			throw;
+		}
+	}
+
+	static void shiftRight(T *items, int count, int location, true_type)
+	{
+		memmove(items + location + 1, items + location,
+			sizeof(T) * (size_t)(count - location));
+	}
+
+	static void shiftRight(T *items, int count, int location, false_type)
+	{
+		//the last item moves into raw storage, so it gets constructed there
+		new (items + count) T(std::move(items[count - 1]));
+		for (int i = count - 1; i > location; i--)
+		{
+			items[i] = std::move(items[i - 1]);
+		}
+	}
+
+	static void shiftLeft(T *items, int count, int index, true_type)
+	{
+		memmove(items + index, items + index + 1,
+			sizeof(T) * (size_t)(count - index - 1));
+	}
+
+	static void shiftLeft(T *items, int count, int index, false_type)
+	{
+		for (int i = index; i < count - 1; i++)
+		{
+			items[i] = std::move(items[i + 1]);
+		}
+	}
+
+public:
+
+	//true_type when items may be copied and shifted as raw bytes
+	typedef integral_constant<bool, is_trivially_copyable<T>::value> trivial_items;
+
+	//returns space for count items, none of which are constructed
+	static T *allocate(int count)
+	{
+		if (count <= 0)
+		{
+			return nullptr;
+		}
+		return static_cast<T *>(::operator new(sizeof(T) * (size_t)count));
+	}
+
+	//returns space from allocate().  Items must already be destroyed.
+	static void release(T *items)
+	{
+		::operator delete(items);
+	}
+
+	//runs the destructor of count live items
+	static void destroy(T *items, int count)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			items[i].~T();
+		}
+	}
+
+	//default-constructs count items into raw space
+	static void defaultConstruct(T *destination, int count)
+	{
+		defaultConstruct(destination, count, is_default_constructible<T>());
+	}
+
+	//copy-constructs count items from source into raw destination.  If a
+	//copy throws, the ones already built are destroyed again.
+	static void copyConstruct(T *destination, const T *source, int count)
+	{
+		copyConstruct(destination, source, count, trivial_items());
+	}
+
+	//moves count items from source into raw destination.  Falls back to
+	//copying when T's move constructor might throw, so a failure leaves
+	//source intact.
+	static void moveConstruct(T *destination, T *source, int count)
+	{
+		moveConstruct(destination, source, count, trivial_items());
+	}
+
+	//opens a hole at location in a run of count live items by moving
+	//[location, count) right by one; slot count becomes live.  The hole
+	//still holds a (moved-from) item.  Requires location < count.
+	static void shiftRight(T *items, int count, int location)
+	{
+		shiftRight(items, count, location, trivial_items());
+	}
+
+	//closes the hole at index by moving (index, count) left by one.  The
+	//old last slot is left holding a (moved-from) item for the caller to
+	//destroy.
+	static void shiftLeft(T *items, int count, int index)
+	{
+		shiftLeft(items, count, index, trivial_items());
+	}
+};
+
+#endif
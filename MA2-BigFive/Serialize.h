@@ -0,0 +1,193 @@
+/*
+ * Serialize.h - Saving and loading containers in the array file format
+ *
+ *  Every container is written as an ArrayFileHeader followed by its items
+ *  as raw bytes (see ArrayFile.h), so the items must be trivially
+ *  copyable.  Lists and arrays write the same bytes for the same items:
+ *  either can load what the other saved, and a saved file can also be
+ *  opened in place as a read-only MappedArray without reading it at all.
+ *
+ *  Saving streams the items out; a list goes through a fixed-size staging
+ *  buffer, so it is never copied whole.  Loading reads the payload in
+ *  chunks and appends each one, to the end of a Vector or of a list's
+ *  chain.  Nothing is sized from the header's count alone, since a short
+ *  or hostile stream can claim any count: memory grows only with the items
+ *  that actually arrive.
+ *
+ *  Failed reads and writes, and streams that don't hold items of T's
+ *  size, throw runtime_error.
+ *
+ */
+
+#ifndef SERIALIZE_H
+#define SERIALIZE_H
+#include <algorithm>
+#include <cstring>
+#include <istream>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+#include "ArrayFile.h"
+#include "Array.h"
+#include "Vector.h"
+#include "LinkedList.h"
+#include "PooledLinkedList.h"
+using namespace std;
+
+//bytes staged per read or write when items are not contiguous
+const int SERIALIZE_CHUNK_BYTES = 1 << 16;
+
+//helpers shared by the functions below
+template <typename T>
+struct SerializeItems
+{
+	static_assert(is_trivially_copyable<T>::value,
+		"Only trivially copyable items can be serialized as raw bytes.");
+
+	//items that fit in one staging chunk
+	static int chunkItems()
+	{
+		return max(1, SERIALIZE_CHUNK_BYTES / (int)sizeof(T));
+	}
+
+	static void writeHeader(ostream &out, int count)
+	{
+		ArrayFileHeader header = arrayFileHeader<T>((uint64_t)count);
+		writeBytes(out, reinterpret_cast<const char *>(&header), sizeof(header));
+	}
+
+	static void writeBytes(ostream &out, const char *bytes, size_t count)
+	{
+		if (!out.write(bytes, (streamsize)count))
+		{
+			throw runtime_error("Could not write container data.");
+		}
+	}
+
+	//reads and checks a header, returning its item count
+	static int readHeader(istream &in)
+	{
+		ArrayFileHeader header;
+		readBytes(in, reinterpret_cast<char *>(&header), sizeof(header));
+		checkArrayFileHeader<T>(header, "Stream");
+		if (header.item_count > (uint64_t)numeric_limits<int>::max())
+		{
+			throw runtime_error("Stream holds more items than a container can.");
+		}
+		return (int)header.item_count;
+	}
+
+	static void readBytes(istream &in, char *bytes, size_t count)
+	{
+		if (!in.read(bytes, (streamsize)count))
+		{
+			throw runtime_error("Stream ended before the container did.");
+		}
+	}
+
+	//reads count items in chunks, handing each chunk to add(items, count)
+	template <typename Add>
+	static void readChunks(istream &in, int count, Add add)
+	{
+		int chunk = chunkItems();
+		vector<char> buffer(sizeof(T) * (size_t)chunk);
+		for (int done = 0; done < count; done += chunk)
+		{
+			int items = min(chunk, count - done);
+			readBytes(in, buffer.data(), sizeof(T) * (size_t)items);
+			add(reinterpret_cast<const T *>(buffer.data()), items);
+		}
+	}
+};
+
+#pragma region saving
+
+//writes the header, then every item in one write
+template <typename T>
+void saveArray(ostream &out, const Array<T> &items)
+{
+	SerializeItems<T>::writeHeader(out, items.getSize());
+	SerializeItems<T>::writeBytes(out, reinterpret_cast<const char *>(items.begin()),
+		sizeof(T) * (size_t)items.getSize());
+}
+
+//writes the header, then the items a staging buffer at a time
+template <typename T>
+void saveList(ostream &out, const LinkedList<T> &items)
+{
+	SerializeItems<T>::writeHeader(out, items.getSize());
+	int chunk = SerializeItems<T>::chunkItems();
+	vector<char> buffer(sizeof(T) * (size_t)chunk);
+	int staged = 0;
+	for (const T &item : items)
+	{
+		memcpy(buffer.data() + sizeof(T) * (size_t)staged, &item, sizeof(T));
+		if (++staged == chunk)
+		{
+			SerializeItems<T>::writeBytes(out, buffer.data(), sizeof(T) * (size_t)staged);
+			staged = 0;
+		}
+	}
+	SerializeItems<T>::writeBytes(out, buffer.data(), sizeof(T) * (size_t)staged);
+}
+
+#pragma endregion
+
+#pragma region loading
+
+//reads a saved container into a Vector.  The header's count is not
+//trusted with an allocation: the vector grows as chunks actually arrive,
+//so a truncated or hostile stream costs no more memory than it holds.
+template <typename T>
+Vector<T> loadVector(istream &in)
+{
+	int count = SerializeItems<T>::readHeader(in);
+	Vector<T> items(min(count, SerializeItems<T>::chunkItems()));
+	SerializeItems<T>::readChunks(in, count, [&](const T *chunk, int chunk_count) {
+		items.addElements(chunk, chunk_count);
+	});
+	return items;
+}
+
+//appends the items of a saved container to the end of items
+template <typename T>
+void loadList(istream &in, LinkedList<T> &items)
+{
+	int count = SerializeItems<T>::readHeader(in);
+	SerializeItems<T>::readChunks(in, count, [&](const T *chunk, int chunk_count) {
+		for (int i = 0; i < chunk_count; i++)
+		{
+			items.addElement(chunk[i]);
+		}
+	});
+}
+
+template <typename T>
+LinkedList<T> loadList(istream &in)
+{
+	LinkedList<T> items;
+	loadList(in, items);
+	return items;
+}
+
+//like loadList, with pool blocks as big as a staging chunk, so each
+//chunk's nodes come from one block
+template <typename T>
+PooledLinkedList<T> loadPooledList(istream &in)
+{
+	int count = SerializeItems<T>::readHeader(in);
+	PooledLinkedList<T> items(max(1, min(count, SerializeItems<T>::chunkItems())));
+	SerializeItems<T>::readChunks(in, count, [&](const T *chunk, int chunk_count) {
+		for (int i = 0; i < chunk_count; i++)
+		{
+			items.addElement(chunk[i]);
+		}
+	});
+	return items;
+}
+
+#pragma endregion
+
+#endif
@@ -0,0 +1,828 @@
+/*
+ * SimdKernels.h - Vectorized search, count, sum, min/max and fill for
+ *   int, float and double
+ *
+ *  Each kernel works on a pointer and an item count, or on an Array<T>
+ *  (and so a Vector<T>) directly.  It is built for several instruction sets:
+ *
+ *    - SIMD_SCALAR: plain loops, on every machine
+ *    - SIMD_SSE2:   128-bit vectors, the x86-64 baseline
+ *    - SIMD_AVX2:   256-bit vectors
+ *    - SIMD_AVX512: 512-bit vectors (AVX-512F)
+ *
+ *  On the first call the best level the CPU and OS support is picked.
+ *  simdSetLevel() can lower it, e.g. to compare levels in a benchmark.
+ *  The vector versions come from SimdLoops.h, which is compiled once per
+ *  instruction set with GCC's target pragma.  That is why this header
+ *  needs no -mavx2 style flags, and why it never runs an instruction the
+ *  CPU lacks.
+ *
+ *  Results match the scalar loops exactly, with one exception.  Floating
+ *  point sums and dot products add in a different order (one running
+ *  total per vector lane), so their last bits can differ.  Sums of ints
+ *  are taken in 64 bits.  With NaNs in the data, the min/max index is
+ *  unspecified.
+ *
+ */
+
+#ifndef SIMD_KERNELS_H
+#define SIMD_KERNELS_H
+
+#include <atomic>
+#include <stdexcept>
+#include <type_traits>
+
+#include "Array.h"
+
+#if defined(__GNUC__) && !defined(__clang__) && (defined(__x86_64__) || defined(__i386__))
+#define SIMD_KERNELS_X86 1
+// GCC 12's AVX-512 intrinsics trip -Wuninitialized on their own
+//  placeholder values when used under a target pragma
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+#pragma GCC diagnostic ignored "-Wmaybe-uninitialized"
+#include <immintrin.h>
+#pragma GCC diagnostic pop
+#endif
+
+using namespace std;
+
+enum SimdLevel
+{
+    SIMD_SCALAR = 0,
+    SIMD_SSE2,
+    SIMD_AVX2,
+    SIMD_AVX512
+};
+
+// The item types the kernels are built for
+template <typename T>
+struct IsSimdType
+{
+    static const bool value = is_same<T, int>::value || is_same<T, float>::value ||
+                              is_same<T, double>::value;
+};
+
+// Result type of simdSum and simdDot: ints are summed in 64 bits
+template <typename T>
+struct SimdSum
+{
+    typedef T type;
+};
+
+template <>
+struct SimdSum<int>
+{
+    typedef long long type;
+};
+
+// Best level this CPU (and OS) can run
+inline SimdLevel simdSupportedLevel()
+{
+#ifdef SIMD_KERNELS_X86
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f"))
+    {
+        return SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2"))
+    {
+        return SIMD_AVX2;
+    }
+    if (__builtin_cpu_supports("sse2"))
+    {
+        return SIMD_SSE2;
+    }
+#endif
+    return SIMD_SCALAR;
+}
+
+inline atomic<int> &simdActiveLevel()
+{
+    static atomic<int> level(simdSupportedLevel());
+    return level;
+}
+
+// Level the kernels currently run at
+inline SimdLevel simdLevel()
+{
+    return (SimdLevel)simdActiveLevel().load(memory_order_relaxed);
+}
+
+// Runs the kernels at level, or the best supported one below it.
+//  Returns the level now in use.
+inline SimdLevel simdSetLevel(SimdLevel level)
+{
+    SimdLevel supported = simdSupportedLevel();
+    if (level > supported)
+    {
+        level = supported;
+    }
+    simdActiveLevel().store(level, memory_order_relaxed);
+    return level;
+}
+
+inline const char *simdLevelName(SimdLevel level)
+{
+    switch (level)
+    {
+    case SIMD_SSE2:
+        return "sse2";
+    case SIMD_AVX2:
+        return "avx2";
+    case SIMD_AVX512:
+        return "avx512";
+    default:
+        return "scalar";
+    }
+}
+
+// Scalar kernels: the fallback, and the reference the vector ones match
+
+template <typename T>
+int simdFindScalar(const T *items, int count, T value)
+{
+    for (int i = 0; i < count; i++)
+    {
+        if (items[i] == value)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <typename T>
+int simdCountScalar(const T *items, int count, T value)
+{
+    int matches = 0;
+    for (int i = 0; i < count; i++)
+    {
+        matches += items[i] == value;
+    }
+    return matches;
+}
+
+template <typename T>
+typename SimdSum<T>::type simdSumScalar(const T *items, int count)
+{
+    typename SimdSum<T>::type total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        total += items[i];
+    }
+    return total;
+}
+
+template <typename T>
+typename SimdSum<T>::type simdDotScalar(const T *left, const T *right, int count)
+{
+    typedef typename SimdSum<T>::type Sum;
+    Sum total = 0;
+    for (int i = 0; i < count; i++)
+    {
+        total += (Sum)left[i] * right[i];
+    }
+    return total;
+}
+
+template <typename T>
+int simdMinIndexScalar(const T *items, int count)
+{
+    int best = count > 0 ? 0 : -1;
+    for (int i = 1; i < count; i++)
+    {
+        if (items[i] < items[best])
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+template <typename T>
+int simdMaxIndexScalar(const T *items, int count)
+{
+    int best = count > 0 ? 0 : -1;
+    for (int i = 1; i < count; i++)
+    {
+        if (items[best] < items[i])
+        {
+            best = i;
+        }
+    }
+    return best;
+}
+
+template <typename T>
+void simdFillScalar(T *items, int count, T value)
+{
+    for (int i = 0; i < count; i++)
+    {
+        items[i] = value;
+    }
+}
+
+template <typename T>
+void simdCopyScalar(T *to, const T *from, int count)
+{
+    for (int i = 0; i < count; i++)
+    {
+        to[i] = from[i];
+    }
+}
+
+#ifdef SIMD_KERNELS_X86
+
+// Per instruction set, SimdXxx<T> wraps the intrinsics SimdLoops.h needs:
+//  WIDTH items per Vec; load, store and splat; equalMask (bit i set when
+//  lane i matches); lanewise min/max and their horizontal lowest/highest;
+//  and an Acc accumulator for sums and dot products.
+
+#define SIMD_INLINE __attribute__((always_inline)) inline
+
+#pragma GCC push_options
+#pragma GCC target("sse2")
+
+template <typename T>
+struct SimdSse2;
+
+template <>
+struct SimdSse2<int>
+{
+    typedef __m128i Vec;
+    typedef __m128i Acc;                        // Two 64-bit totals
+    static const int WIDTH = 4;
+
+    static SIMD_INLINE Vec load(const int *items) { return _mm_loadu_si128((const __m128i *)items); }
+    static SIMD_INLINE void store(int *items, Vec v) { _mm_storeu_si128((__m128i *)items, v); }
+    static SIMD_INLINE Vec splat(int value) { return _mm_set1_epi32(value); }
+
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b)
+    {
+        return (unsigned)_mm_movemask_ps(_mm_castsi128_ps(_mm_cmpeq_epi32(a, b)));
+    }
+
+    // SSE2 has no 32-bit min/max; pick lanes with a compare mask
+    static SIMD_INLINE Vec min(Vec a, Vec b)
+    {
+        Vec less = _mm_cmplt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(less, a), _mm_andnot_si128(less, b));
+    }
+
+    static SIMD_INLINE Vec max(Vec a, Vec b)
+    {
+        Vec greater = _mm_cmpgt_epi32(a, b);
+        return _mm_or_si128(_mm_and_si128(greater, a), _mm_andnot_si128(greater, b));
+    }
+
+    static SIMD_INLINE int lowest(Vec v)
+    {
+        int lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMinIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE int highest(Vec v)
+    {
+        int lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMaxIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE Acc zero() { return _mm_setzero_si128(); }
+
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v)
+    {
+        Vec sign = _mm_srai_epi32(v, 31);
+        sums = _mm_add_epi64(sums, _mm_unpacklo_epi32(v, sign));
+        return _mm_add_epi64(sums, _mm_unpackhi_epi32(v, sign));
+    }
+
+    // Signed 32x32->64 products of the even lanes.  SSE2 only multiplies
+    //  unsigned, so take b (a) back off the high half where a (b) < 0.
+    static SIMD_INLINE __m128i evenProducts(Vec a, Vec b)
+    {
+        __m128i product = _mm_mul_epu32(a, b);
+        __m128i fix = _mm_add_epi32(_mm_and_si128(_mm_srai_epi32(a, 31), b),
+                                    _mm_and_si128(_mm_srai_epi32(b, 31), a));
+        return _mm_sub_epi64(product, _mm_slli_epi64(fix, 32));
+    }
+
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b)
+    {
+        sums = _mm_add_epi64(sums, evenProducts(a, b));
+        return _mm_add_epi64(sums, evenProducts(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32)));
+    }
+
+    static SIMD_INLINE long long total(Acc sums)
+    {
+        long long lanes[2];
+        _mm_storeu_si128((__m128i *)lanes, sums);
+        return lanes[0] + lanes[1];
+    }
+};
+
+template <>
+struct SimdSse2<float>
+{
+    typedef __m128 Vec;
+    typedef __m128 Acc;
+    static const int WIDTH = 4;
+
+    static SIMD_INLINE Vec load(const float *items) { return _mm_loadu_ps(items); }
+    static SIMD_INLINE void store(float *items, Vec v) { _mm_storeu_ps(items, v); }
+    static SIMD_INLINE Vec splat(float value) { return _mm_set1_ps(value); }
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b) { return (unsigned)_mm_movemask_ps(_mm_cmpeq_ps(a, b)); }
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm_min_ps(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm_max_ps(a, b); }
+
+    static SIMD_INLINE float lowest(Vec v)
+    {
+        float lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMinIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE float highest(Vec v)
+    {
+        float lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMaxIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE Acc zero() { return _mm_setzero_ps(); }
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v) { return _mm_add_ps(sums, v); }
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b) { return _mm_add_ps(sums, _mm_mul_ps(a, b)); }
+
+    static SIMD_INLINE float total(Acc sums)
+    {
+        float lanes[WIDTH];
+        store(lanes, sums);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+template <>
+struct SimdSse2<double>
+{
+    typedef __m128d Vec;
+    typedef __m128d Acc;
+    static const int WIDTH = 2;
+
+    static SIMD_INLINE Vec load(const double *items) { return _mm_loadu_pd(items); }
+    static SIMD_INLINE void store(double *items, Vec v) { _mm_storeu_pd(items, v); }
+    static SIMD_INLINE Vec splat(double value) { return _mm_set1_pd(value); }
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b) { return (unsigned)_mm_movemask_pd(_mm_cmpeq_pd(a, b)); }
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm_min_pd(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+
+    static SIMD_INLINE double lowest(Vec v)
+    {
+        double lanes[WIDTH];
+        store(lanes, v);
+        return lanes[1] < lanes[0] ? lanes[1] : lanes[0];
+    }
+
+    static SIMD_INLINE double highest(Vec v)
+    {
+        double lanes[WIDTH];
+        store(lanes, v);
+        return lanes[0] < lanes[1] ? lanes[1] : lanes[0];
+    }
+
+    static SIMD_INLINE Acc zero() { return _mm_setzero_pd(); }
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v) { return _mm_add_pd(sums, v); }
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b) { return _mm_add_pd(sums, _mm_mul_pd(a, b)); }
+
+    static SIMD_INLINE double total(Acc sums)
+    {
+        double lanes[WIDTH];
+        store(lanes, sums);
+        return lanes[0] + lanes[1];
+    }
+};
+
+// No popcnt instruction before SSE4.2; SSE2 masks have at most 4 bits,
+//  so look the count up in a table of nibbles
+inline int simdBitCountSse2(unsigned mask)
+{
+    return (int)((0x4332322132212110ULL >> (mask * 4)) & 0xF);
+}
+
+#define SIMD_OPS SimdSse2
+#define SIMD_KERNEL(name) name##Sse2
+#include "SimdLoops.h"
+#undef SIMD_OPS
+#undef SIMD_KERNEL
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx2")
+
+template <typename T>
+struct SimdAvx2;
+
+template <>
+struct SimdAvx2<int>
+{
+    typedef __m256i Vec;
+    typedef __m256i Acc;                        // Four 64-bit totals
+    static const int WIDTH = 8;
+
+    static SIMD_INLINE Vec load(const int *items) { return _mm256_loadu_si256((const __m256i *)items); }
+    static SIMD_INLINE void store(int *items, Vec v) { _mm256_storeu_si256((__m256i *)items, v); }
+    static SIMD_INLINE Vec splat(int value) { return _mm256_set1_epi32(value); }
+
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b)
+    {
+        return (unsigned)_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(a, b)));
+    }
+
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm256_min_epi32(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm256_max_epi32(a, b); }
+
+    static SIMD_INLINE int lowest(Vec v)
+    {
+        __m128i half = _mm_min_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_min_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+    }
+
+    static SIMD_INLINE int highest(Vec v)
+    {
+        __m128i half = _mm_max_epi32(_mm256_castsi256_si128(v), _mm256_extracti128_si256(v, 1));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(1, 0, 3, 2)));
+        half = _mm_max_epi32(half, _mm_shuffle_epi32(half, _MM_SHUFFLE(2, 3, 0, 1)));
+        return _mm_cvtsi128_si32(half);
+    }
+
+    static SIMD_INLINE Acc zero() { return _mm256_setzero_si256(); }
+
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v)
+    {
+        sums = _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_castsi256_si128(v)));
+        return _mm256_add_epi64(sums, _mm256_cvtepi32_epi64(_mm256_extracti128_si256(v, 1)));
+    }
+
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b)
+    {
+        sums = _mm256_add_epi64(sums, _mm256_mul_epi32(a, b));
+        return _mm256_add_epi64(sums, _mm256_mul_epi32(_mm256_srli_epi64(a, 32),
+                                                         _mm256_srli_epi64(b, 32)));
+    }
+
+    static SIMD_INLINE long long total(Acc sums)
+    {
+        long long lanes[4];
+        _mm256_storeu_si256((__m256i *)lanes, sums);
+        return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]);
+    }
+};
+
+template <>
+struct SimdAvx2<float>
+{
+    typedef __m256 Vec;
+    typedef __m256 Acc;
+    static const int WIDTH = 8;
+
+    static SIMD_INLINE Vec load(const float *items) { return _mm256_loadu_ps(items); }
+    static SIMD_INLINE void store(float *items, Vec v) { _mm256_storeu_ps(items, v); }
+    static SIMD_INLINE Vec splat(float value) { return _mm256_set1_ps(value); }
+
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b)
+    {
+        return (unsigned)_mm256_movemask_ps(_mm256_cmp_ps(a, b, _CMP_EQ_OQ));
+    }
+
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm256_min_ps(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm256_max_ps(a, b); }
+
+    static SIMD_INLINE float lowest(Vec v)
+    {
+        float lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMinIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE float highest(Vec v)
+    {
+        float lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMaxIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE Acc zero() { return _mm256_setzero_ps(); }
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v) { return _mm256_add_ps(sums, v); }
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b) { return _mm256_add_ps(sums, _mm256_mul_ps(a, b)); }
+
+    static SIMD_INLINE float total(Acc sums)
+    {
+        __m128 half = _mm_add_ps(_mm256_castps256_ps128(sums), _mm256_extractf128_ps(sums, 1));
+        half = _mm_add_ps(half, _mm_movehl_ps(half, half));
+        half = _mm_add_ss(half, _mm_shuffle_ps(half, half, 1));
+        return _mm_cvtss_f32(half);
+    }
+};
+
+template <>
+struct SimdAvx2<double>
+{
+    typedef __m256d Vec;
+    typedef __m256d Acc;
+    static const int WIDTH = 4;
+
+    static SIMD_INLINE Vec load(const double *items) { return _mm256_loadu_pd(items); }
+    static SIMD_INLINE void store(double *items, Vec v) { _mm256_storeu_pd(items, v); }
+    static SIMD_INLINE Vec splat(double value) { return _mm256_set1_pd(value); }
+
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b)
+    {
+        return (unsigned)_mm256_movemask_pd(_mm256_cmp_pd(a, b, _CMP_EQ_OQ));
+    }
+
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm256_min_pd(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+
+    static SIMD_INLINE double lowest(Vec v)
+    {
+        double lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMinIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE double highest(Vec v)
+    {
+        double lanes[WIDTH];
+        store(lanes, v);
+        return lanes[simdMaxIndexScalar(lanes, WIDTH)];
+    }
+
+    static SIMD_INLINE Acc zero() { return _mm256_setzero_pd(); }
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v) { return _mm256_add_pd(sums, v); }
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b) { return _mm256_add_pd(sums, _mm256_mul_pd(a, b)); }
+
+    static SIMD_INLINE double total(Acc sums)
+    {
+        __m128d half = _mm_add_pd(_mm256_castpd256_pd128(sums), _mm256_extractf128_pd(sums, 1));
+        return _mm_cvtsd_f64(_mm_add_sd(half, _mm_unpackhi_pd(half, half)));
+    }
+};
+
+inline int simdBitCountAvx2(unsigned mask)
+{
+    return __builtin_popcount(mask);
+}
+
+#define SIMD_OPS SimdAvx2
+#define SIMD_KERNEL(name) name##Avx2
+#include "SimdLoops.h"
+#undef SIMD_OPS
+#undef SIMD_KERNEL
+
+#pragma GCC pop_options
+
+#pragma GCC push_options
+#pragma GCC target("avx512f")
+
+template <typename T>
+struct SimdAvx512;
+
+template <>
+struct SimdAvx512<int>
+{
+    typedef __m512i Vec;
+    typedef __m512i Acc;                        // Eight 64-bit totals
+    static const int WIDTH = 16;
+
+    static SIMD_INLINE Vec load(const int *items) { return _mm512_loadu_si512(items); }
+    static SIMD_INLINE void store(int *items, Vec v) { _mm512_storeu_si512(items, v); }
+    static SIMD_INLINE Vec splat(int value) { return _mm512_set1_epi32(value); }
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b) { return (unsigned)_mm512_cmpeq_epi32_mask(a, b); }
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm512_min_epi32(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm512_max_epi32(a, b); }
+    static SIMD_INLINE int lowest(Vec v) { return _mm512_reduce_min_epi32(v); }
+    static SIMD_INLINE int highest(Vec v) { return _mm512_reduce_max_epi32(v); }
+    static SIMD_INLINE Acc zero() { return _mm512_setzero_si512(); }
+
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v)
+    {
+        sums = _mm512_add_epi64(sums, _mm512_cvtepi32_epi64(_mm512_castsi512_si256(v)));
+        return _mm512_add_epi64(sums, _mm512_cvtepi32_epi64(_mm512_extracti64x4_epi64(v, 1)));
+    }
+
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b)
+    {
+        sums = _mm512_add_epi64(sums, _mm512_mul_epi32(a, b));
+        return _mm512_add_epi64(sums, _mm512_mul_epi32(_mm512_srli_epi64(a, 32),
+                                                         _mm512_srli_epi64(b, 32)));
+    }
+
+    static SIMD_INLINE long long total(Acc sums) { return _mm512_reduce_add_epi64(sums); }
+};
+
+template <>
+struct SimdAvx512<float>
+{
+    typedef __m512 Vec;
+    typedef __m512 Acc;
+    static const int WIDTH = 16;
+
+    static SIMD_INLINE Vec load(const float *items) { return _mm512_loadu_ps(items); }
+    static SIMD_INLINE void store(float *items, Vec v) { _mm512_storeu_ps(items, v); }
+    static SIMD_INLINE Vec splat(float value) { return _mm512_set1_ps(value); }
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b) { return (unsigned)_mm512_cmp_ps_mask(a, b, _CMP_EQ_OQ); }
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm512_min_ps(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm512_max_ps(a, b); }
+    static SIMD_INLINE float lowest(Vec v) { return _mm512_reduce_min_ps(v); }
+    static SIMD_INLINE float highest(Vec v) { return _mm512_reduce_max_ps(v); }
+    static SIMD_INLINE Acc zero() { return _mm512_setzero_ps(); }
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v) { return _mm512_add_ps(sums, v); }
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b) { return _mm512_add_ps(sums, _mm512_mul_ps(a, b)); }
+    static SIMD_INLINE float total(Acc sums) { return _mm512_reduce_add_ps(sums); }
+};
+
+template <>
+struct SimdAvx512<double>
+{
+    typedef __m512d Vec;
+    typedef __m512d Acc;
+    static const int WIDTH = 8;
+
+    static SIMD_INLINE Vec load(const double *items) { return _mm512_loadu_pd(items); }
+    static SIMD_INLINE void store(double *items, Vec v) { _mm512_storeu_pd(items, v); }
+    static SIMD_INLINE Vec splat(double value) { return _mm512_set1_pd(value); }
+    static SIMD_INLINE unsigned equalMask(Vec a, Vec b) { return (unsigned)_mm512_cmp_pd_mask(a, b, _CMP_EQ_OQ); }
+    static SIMD_INLINE Vec min(Vec a, Vec b) { return _mm512_min_pd(a, b); }
+    static SIMD_INLINE Vec max(Vec a, Vec b) { return _mm512_max_pd(a, b); }
+    static SIMD_INLINE double lowest(Vec v) { return _mm512_reduce_min_pd(v); }
+    static SIMD_INLINE double highest(Vec v) { return _mm512_reduce_max_pd(v); }
+    static SIMD_INLINE Acc zero() { return _mm512_setzero_pd(); }
+    static SIMD_INLINE Acc accumulate(Acc sums, Vec v) { return _mm512_add_pd(sums, v); }
+    static SIMD_INLINE Acc accumulateProduct(Acc sums, Vec a, Vec b) { return _mm512_add_pd(sums, _mm512_mul_pd(a, b)); }
+    static SIMD_INLINE double total(Acc sums) { return _mm512_reduce_add_pd(sums); }
+};
+
+inline int simdBitCountAvx512(unsigned mask)
+{
+    return __builtin_popcount(mask);
+}
+
+#define SIMD_OPS SimdAvx512
+#define SIMD_KERNEL(name) name##Avx512
+#include "SimdLoops.h"
+#undef SIMD_OPS
+#undef SIMD_KERNEL
+
+#pragma GCC pop_options
+
+#undef SIMD_INLINE
+
+// Calls the kernel built for the active level
+#define SIMD_DISPATCH(name, ...)                                        \
+    switch (simdLevel())                                                \
+    {                                                                   \
+    case SIMD_AVX512:                                                   \
+        return name##Avx512(__VA_ARGS__);                               \
+    case SIMD_AVX2:                                                     \
+        return name##Avx2(__VA_ARGS__);                                 \
+    case SIMD_SSE2:                                                     \
+        return name##Sse2(__VA_ARGS__);                                 \
+    default:                                                            \
+        return name##Scalar(__VA_ARGS__);                               \
+    }
+
+#else
+
+#define SIMD_DISPATCH(name, ...) return name##Scalar(__VA_ARGS__);
+
+#endif
+
+// Index of the first item equal to value, or -1
+template <typename T>
+int simdFind(const T *items, int count, T value)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdFind, items, count, value)
+}
+
+// Number of items equal to value
+template <typename T>
+int simdCount(const T *items, int count, T value)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdCount, items, count, value)
+}
+
+template <typename T>
+typename SimdSum<T>::type simdSum(const T *items, int count)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdSum, items, count)
+}
+
+// Sum of left[i] * right[i]
+template <typename T>
+typename SimdSum<T>::type simdDot(const T *left, const T *right, int count)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdDot, left, right, count)
+}
+
+// Index of the first smallest item, or -1 when there are none
+template <typename T>
+int simdMinIndex(const T *items, int count)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdMinIndex, items, count)
+}
+
+// Index of the first largest item, or -1 when there are none
+template <typename T>
+int simdMaxIndex(const T *items, int count)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdMaxIndex, items, count)
+}
+
+template <typename T>
+void simdFill(T *items, int count, T value)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdFill, items, count, value)
+}
+
+// The ranges must not overlap
+template <typename T>
+void simdCopy(T *to, const T *from, int count)
+{
+    static_assert(IsSimdType<T>::value, "SIMD kernels support int, float and double");
+    SIMD_DISPATCH(simdCopy, to, from, count)
+}
+
+#undef SIMD_DISPATCH
+
+// Array versions, over the items currently in the array
+
+template <typename T>
+int simdFind(const Array<T> &items, T value)
+{
+    return simdFind(items.begin(), items.getSize(), value);
+}
+
+template <typename T>
+int simdCount(const Array<T> &items, T value)
+{
+    return simdCount(items.begin(), items.getSize(), value);
+}
+
+template <typename T>
+typename SimdSum<T>::type simdSum(const Array<T> &items)
+{
+    return simdSum(items.begin(), items.getSize());
+}
+
+template <typename T>
+typename SimdSum<T>::type simdDot(const Array<T> &left, const Array<T> &right)
+{
+    if (left.getSize() != right.getSize())
+    {
+        throw invalid_argument("Arrays must be the same size.");
+    }
+    return simdDot(left.begin(), right.begin(), left.getSize());
+}
+
+template <typename T>
+int simdMinIndex(const Array<T> &items)
+{
+    return simdMinIndex(items.begin(), items.getSize());
+}
+
+template <typename T>
+int simdMaxIndex(const Array<T> &items)
+{
+    return simdMaxIndex(items.begin(), items.getSize());
+}
+
+// Overwrites every item; the size stays the same
+template <typename T>
+void simdFill(Array<T> &items, T value)
+{
+    simdFill(items.begin(), items.getSize(), value);
+}
+
+// to must already hold as many items as from
+template <typename T>
+void simdCopy(const Array<T> &from, Array<T> &to)
+{
+    if (from.getSize() != to.getSize())
+    {
+        throw invalid_argument("Arrays must be the same size.");
+    }
+    simdCopy(to.begin(), from.begin(), from.getSize());
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ * SimdLoops.h - Kernel loops shared by every instruction set
+ *
+ *  Not a standalone header: SimdKernels.h includes it once per instruction
+ *  set, inside a GCC target pragma.  It defines SIMD_OPS as the intrinsics
+ *  wrapper (SimdSse2, SimdAvx2, ...) and SIMD_KERNEL(name) to add the
+ *  matching suffix, and provides SIMD_KERNEL(simdBitCount) to count the
+ *  bits of an equalMask.  Whole vectors go through SIMD_OPS<T>, and whatever
+ *  is left over at the end is handled one item at a time.
+ *
+ */
+
+template <typename T>
+int SIMD_KERNEL(simdFind)(const T *items, int count, T value)
+{
+    typedef SIMD_OPS<T> Ops;
+    typename Ops::Vec wanted = Ops::splat(value);
+    int i = 0;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        unsigned matches = Ops::equalMask(Ops::load(items + i), wanted);
+        if (matches != 0)
+        {
+            return i + __builtin_ctz(matches);
+        }
+    }
+    for (; i < count; i++)
+    {
+        if (items[i] == value)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+template <typename T>
+int SIMD_KERNEL(simdCount)(const T *items, int count, T value)
+{
+    typedef SIMD_OPS<T> Ops;
+    typename Ops::Vec wanted = Ops::splat(value);
+    int matches = 0;
+    int i = 0;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        matches += SIMD_KERNEL(simdBitCount)(Ops::equalMask(Ops::load(items + i), wanted));
+    }
+    for (; i < count; i++)
+    {
+        matches += items[i] == value;
+    }
+    return matches;
+}
+
+template <typename T>
+typename SimdSum<T>::type SIMD_KERNEL(simdSum)(const T *items, int count)
+{
+    typedef SIMD_OPS<T> Ops;
+    typename Ops::Acc sums = Ops::zero();
+    int i = 0;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        sums = Ops::accumulate(sums, Ops::load(items + i));
+    }
+    typename SimdSum<T>::type result = Ops::total(sums);
+    for (; i < count; i++)
+    {
+        result += items[i];
+    }
+    return result;
+}
+
+template <typename T>
+typename SimdSum<T>::type SIMD_KERNEL(simdDot)(const T *left, const T *right, int count)
+{
+    typedef SIMD_OPS<T> Ops;
+    typedef typename SimdSum<T>::type Sum;
+    typename Ops::Acc sums = Ops::zero();
+    int i = 0;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        sums = Ops::accumulateProduct(sums, Ops::load(left + i), Ops::load(right + i));
+    }
+    Sum result = Ops::total(sums);
+    for (; i < count; i++)
+    {
+        result += (Sum)left[i] * right[i];
+    }
+    return result;
+}
+
+// Both extremes work in two passes: find the smallest (largest) value a
+//  vector at a time, then the first index holding it
+template <typename T>
+int SIMD_KERNEL(simdMinIndex)(const T *items, int count)
+{
+    typedef SIMD_OPS<T> Ops;
+    if (count < Ops::WIDTH)
+    {
+        return simdMinIndexScalar(items, count);
+    }
+    typename Ops::Vec lows = Ops::load(items);
+    int i = Ops::WIDTH;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        lows = Ops::min(lows, Ops::load(items + i));
+    }
+    T best = Ops::lowest(lows);
+    for (; i < count; i++)
+    {
+        if (items[i] < best)
+        {
+            best = items[i];
+        }
+    }
+    return SIMD_KERNEL(simdFind)(items, count, best);
+}
+
+template <typename T>
+int SIMD_KERNEL(simdMaxIndex)(const T *items, int count)
+{
+    typedef SIMD_OPS<T> Ops;
+    if (count < Ops::WIDTH)
+    {
+        return simdMaxIndexScalar(items, count);
+    }
+    typename Ops::Vec highs = Ops::load(items);
+    int i = Ops::WIDTH;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        highs = Ops::max(highs, Ops::load(items + i));
+    }
+    T best = Ops::highest(highs);
+    for (; i < count; i++)
+    {
+        if (best < items[i])
+        {
+            best = items[i];
+        }
+    }
+    return SIMD_KERNEL(simdFind)(items, count, best);
+}
+
+template <typename T>
+void SIMD_KERNEL(simdFill)(T *items, int count, T value)
+{
+    typedef SIMD_OPS<T> Ops;
+    typename Ops::Vec filler = Ops::splat(value);
+    int i = 0;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        Ops::store(items + i, filler);
+    }
+    for (; i < count; i++)
+    {
+        items[i] = value;
+    }
+}
+
+template <typename T>
+void SIMD_KERNEL(simdCopy)(T *to, const T *from, int count)
+{
+    typedef SIMD_OPS<T> Ops;
+    int i = 0;
+    for (; i + Ops::WIDTH <= count; i += Ops::WIDTH)
+    {
+        Ops::store(to + i, Ops::load(from + i));
+    }
+    for (; i < count; i++)
+    {
+        to[i] = from[i];
+    }
+}
@@ -0,0 +1,569 @@
+/*
+ * SkipList.h - Indexable skip list implementing Indexed<T>
+ *
+ *  Every forward link also stores its span ("width"): how many positions
+ *  it skips.  Walking down from the top level while adding up widths
+ *  finds any position in expected O(log n), so getElementAt, setElementAt,
+ *  addElementAt and removeElementAt are all expected O(log n) regardless of
+ *  the access pattern.
+ *
+ *  Positions: the head sits at -1, items at 0..size-1, and a link with no
+ *  next node points at position size.  So a link's width is always
+ *  (position of next) - (position of this).
+ *
+ */
+
+#ifndef SKIP_LIST_H
+#define SKIP_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Indexed.h"
+
+using namespace std;
+
+template <typename T>
+class SkipListNode;
+
+// One forward pointer of a skip list node plus the distance it covers
+template <typename T>
+struct SkipListLink
+{
+    SkipListNode<T> *next;
+    int width;
+};
+
+template <typename T>
+class SkipListNode
+{
+private:
+    T _value;
+    int _level;                     // Number of links this node has
+    SkipListLink<T> *_links;        // _links[0] is the plain linked list
+
+public:
+
+    // The value is built in place from args
+    template <typename... Args>
+    SkipListNode(int level, Args &&... args)
+        : _value(std::forward<Args>(args)...), _level(level), _links(new SkipListLink<T>[level])
+    {
+    }
+
+    SkipListNode(const SkipListNode<T> &other) = delete;
+    SkipListNode<T> &operator=(const SkipListNode<T> &other) = delete;
+
+    ~SkipListNode()
+    {
+        delete[] _links;
+    }
+
+    T &getValue()
+    {
+        return _value;
+    }
+
+    const T &getValue() const
+    {
+        return _value;
+    }
+
+    int getLevel() const
+    {
+        return _level;
+    }
+
+    SkipListLink<T> &getLink(int level)
+    {
+        return _links[level];
+    }
+
+    const SkipListLink<T> &getLink(int level) const
+    {
+        return _links[level];
+    }
+
+    SkipListNode<T> *getNext() const
+    {
+        return _links[0].next;
+    }
+};
+
+
+// Forward iterator along the bottom level of a SkipList
+template <typename T, bool IsConst>
+class SkipListIterator
+{
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename conditional<IsConst, const T *, T *>::type pointer;
+    typedef typename conditional<IsConst, const T &, T &>::type reference;
+    typedef typename conditional<IsConst, const SkipListNode<T>,
+                                 SkipListNode<T> >::type node_type;
+
+private:
+    node_type *_node;
+
+public:
+
+    SkipListIterator(node_type *node = nullptr) : _node(node)
+    {
+    }
+
+    template <bool OtherConst,
+              typename = typename enable_if<IsConst && !OtherConst>::type>
+    SkipListIterator(const SkipListIterator<T, OtherConst> &other)
+        : _node(other.getNode())
+    {
+    }
+
+    node_type *getNode() const
+    {
+        return _node;
+    }
+
+    reference operator*() const
+    {
+        return _node->getValue();
+    }
+
+    pointer operator->() const
+    {
+        return &_node->getValue();
+    }
+
+    SkipListIterator<T, IsConst> &operator++()
+    {
+        _node = _node->getNext();
+        return *this;
+    }
+
+    SkipListIterator<T, IsConst> operator++(int)
+    {
+        SkipListIterator<T, IsConst> previous = *this;
+        _node = _node->getNext();
+        return previous;
+    }
+
+    bool operator==(const SkipListIterator<T, IsConst> &other) const
+    {
+        return _node == other._node;
+    }
+
+    bool operator!=(const SkipListIterator<T, IsConst> &other) const
+    {
+        return _node != other._node;
+    }
+};
+
+
+template <typename T>
+class SkipList : public Indexed<T>
+{
+public:
+    static const int MAX_LEVEL = 32;    // Plenty for 2^31 items at p = 1/2
+
+private:
+    typedef SkipListNode<T> Node;
+    typedef SkipListLink<T> Link;
+
+    Link _head[MAX_LEVEL];      // Links out of the head, one per level
+    int _level = 1;             // Levels in use (at least the bottom one)
+    int _size = 0;
+    uint32_t _seed = 2463534242u;
+
+    // Coin flips from a xorshift generator: level k with probability 2^-k
+    int randomLevel()
+    {
+        _seed ^= _seed << 13;
+        _seed ^= _seed >> 17;
+        _seed ^= _seed << 5;
+        int level = 1;
+        uint32_t bits = _seed;
+        while (level < MAX_LEVEL && (bits & 1u) != 0)
+        {
+            level++;
+            bits >>= 1;
+        }
+        return level;
+    }
+
+    // Link of the head (when node is nullptr) or of a node
+    Link &linkOf(Node *node, int level)
+    {
+        return node == nullptr ? _head[level] : node->getLink(level);
+    }
+
+    const Link &linkOf(const Node *node, int level) const
+    {
+        return node == nullptr ? _head[level] : node->getLink(level);
+    }
+
+    // Empty list: every head link reaches the end position 0, one step away
+    void resetHead()
+    {
+        for (int i = 0; i < MAX_LEVEL; i++)
+        {
+            _head[i].next = nullptr;
+            _head[i].width = 1;
+        }
+        _level = 1;
+        _size = 0;
+    }
+
+    // Fills update[] with the last node before position index on every
+    //  level in use (nullptr meaning the head) and positions[] with where
+    //  those nodes sit
+    void findPredecessors(int index, Node **update, int *positions)
+    {
+        Node *current = nullptr;
+        int position = -1;
+        for (int level = _level - 1; level >= 0; level--)
+        {
+            Link *link = &linkOf(current, level);
+            while (link->next != nullptr && position + link->width < index)
+            {
+                position += link->width;
+                current = link->next;
+                link = &current->getLink(level);
+            }
+            update[level] = current;
+            positions[level] = position;
+        }
+    }
+
+    const Node *findNode(int index) const
+    {
+        if (index < 0 || index >= _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+        const Node *current = nullptr;
+        int position = -1;
+        for (int level = _level - 1; level >= 0; level--)
+        {
+            const Link *link = &linkOf(current, level);
+            while (link->next != nullptr && position + link->width <= index)
+            {
+                position += link->width;
+                current = link->next;
+                link = &current->getLink(level);
+            }
+            if (position == index)
+            {
+                break;
+            }
+        }
+        return current;
+    }
+
+    Node *findNode(int index)
+    {
+        return const_cast<Node *>(static_cast<const SkipList<T> *>(this)->findNode(index));
+    }
+
+    // Rebuilds other's exact tower structure in O(n)
+    void copyFrom(const SkipList<T> &other)
+    {
+        Node *last[MAX_LEVEL];
+        for (int i = 0; i < MAX_LEVEL; i++)
+        {
+            _head[i].next = nullptr;
+            _head[i].width = other._head[i].width;
+            last[i] = nullptr;
+        }
+        _level = other._level;
+        _size = 0;
+        _seed = other._seed;
+
+        for (const Node *source = other._head[0].next; source != nullptr; source = source->getNext())
+        {
+            Node *copy = new Node(source->getLevel(), source->getValue());
+            for (int level = 0; level < copy->getLevel(); level++)
+            {
+                copy->getLink(level).next = nullptr;
+                copy->getLink(level).width = source->getLink(level).width;
+                linkOf(last[level], level).next = copy;
+                last[level] = copy;
+            }
+            _size++;
+        }
+    }
+
+    void stealFrom(SkipList<T> &other)
+    {
+        for (int i = 0; i < MAX_LEVEL; i++)
+        {
+            _head[i] = other._head[i];
+        }
+        _level = other._level;
+        _size = other._size;
+        _seed = other._seed;
+        other.resetHead();
+    }
+
+public:
+    typedef SkipListIterator<T, false> iterator;
+    typedef SkipListIterator<T, true> const_iterator;
+
+    SkipList()
+    {
+        resetHead();
+    }
+
+    SkipList(const SkipList<T> &other)
+    {
+        resetHead();
+        try
+        {
+            copyFrom(other);
+        }
+        catch (...)
+        {
+            // Whatever got linked in so far is reachable along level 0
+            clear();
+            throw;
+        }
+    }
+
+    SkipList(SkipList<T> &&other)
+    {
+        stealFrom(other);
+    }
+
+    SkipList(initializer_list<T> values)
+    {
+        resetHead();
+        for (auto item : values)
+        {
+            addElement(item);
+        }
+    }
+
+    virtual ~SkipList()
+    {
+        clear();
+    }
+
+    virtual SkipList<T> &operator=(const SkipList<T> &other)
+    {
+        if (this != &other)
+        {
+            SkipList<T> copy{ other };
+            clear();
+            stealFrom(copy);
+        }
+        return *this;
+    }
+
+    virtual SkipList<T> &operator=(SkipList<T> &&other)
+    {
+        if (this != &other)
+        {
+            clear();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    // Frees every node in one pass along the bottom level
+    void clear()
+    {
+        Node *current = _head[0].next;
+        while (current != nullptr)
+        {
+            Node *next = current->getNext();
+            delete current;
+            current = next;
+        }
+        resetHead();
+    }
+
+    virtual bool isEmpty() const final
+    {
+        return _size == 0;
+    }
+
+    virtual int getSize() const final
+    {
+        return _size;
+    }
+
+    virtual void addElement(const T &value)
+    {
+        emplaceElementAt(_size, value);
+    }
+
+    virtual void addElement(T &&value)
+    {
+        emplaceElementAt(_size, std::move(value));
+    }
+
+    template <typename... Args>
+    void emplaceElement(Args &&... args)
+    {
+        emplaceElementAt(_size, std::forward<Args>(args)...);
+    }
+
+    virtual T &getElementAt(int index) final
+    {
+        return findNode(index)->getValue();
+    }
+
+    virtual const T &getElementAt(int index) const final
+    {
+        return findNode(index)->getValue();
+    }
+
+    virtual void setElementAt(const T &value, int index) final
+    {
+        findNode(index)->getValue() = value;
+    }
+
+    virtual void setElementAt(T &&value, int index) final
+    {
+        findNode(index)->getValue() = std::move(value);
+    }
+
+    virtual void addElementAt(const T &value, int index)
+    {
+        emplaceElementAt(index, value);
+    }
+
+    virtual void addElementAt(T &&value, int index)
+    {
+        emplaceElementAt(index, std::move(value));
+    }
+
+    // Builds the new node's value straight from args
+    template <typename... Args>
+    void emplaceElementAt(int index, Args &&... args)
+    {
+        if (index < 0 || index > _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+
+        // Built before anything is relinked, so a throwing constructor
+        //  leaves the list untouched
+        int new_level = randomLevel();
+        Node *node = new Node(new_level, std::forward<Args>(args)...);
+        Node *update[MAX_LEVEL] = {};
+        int positions[MAX_LEVEL] = {};
+        findPredecessors(index, update, positions);
+
+        // Levels we have never used before start at the head
+        for (int level = _level; level < new_level; level++)
+        {
+            update[level] = nullptr;
+            positions[level] = -1;
+        }
+        if (new_level > _level)
+        {
+            _level = new_level;
+        }
+
+        for (int level = 0; level < new_level; level++)
+        {
+            Link &before = linkOf(update[level], level);
+            Link &after = node->getLink(level);
+
+            // The old link covered positions[level] .. positions[level] + width;
+            //  we now sit at index and everything at or after it moved up one
+            after.next = before.next;
+            after.width = positions[level] + before.width + 1 - index;
+            before.next = node;
+            before.width = index - positions[level];
+        }
+
+        // Taller links that jump over the new node now span one more position
+        for (int level = new_level; level < _level; level++)
+        {
+            linkOf(update[level], level).width++;
+        }
+        for (int level = _level; level < MAX_LEVEL; level++)
+        {
+            _head[level].width++;
+        }
+        _size++;
+    }
+
+    virtual void removeElementAt(int index)
+    {
+        if (index < 0 || index >= _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+
+        Node *update[MAX_LEVEL] = {};
+        int positions[MAX_LEVEL] = {};
+        findPredecessors(index, update, positions);
+        Node *target = linkOf(update[0], 0).next;
+
+        for (int level = 0; level < _level; level++)
+        {
+            Link &before = linkOf(update[level], level);
+            if (before.next == target)
+            {
+                before.width += target->getLink(level).width - 1;
+                before.next = target->getLink(level).next;
+            }
+            else
+            {
+                before.width--;
+            }
+        }
+        for (int level = _level; level < MAX_LEVEL; level++)
+        {
+            _head[level].width--;
+        }
+        delete target;
+        _size--;
+
+        // Drop levels that no longer lead anywhere
+        while (_level > 1 && _head[_level - 1].next == nullptr)
+        {
+            _level--;
+        }
+    }
+
+    iterator begin()
+    {
+        return iterator(_head[0].next);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_head[0].next);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+#endif
@@ -0,0 +1,239 @@
+/*
+ * SmallArray.h - A Vector that keeps its first N items inside the object
+ *
+ *  Until it holds more than N items, a SmallArray needs no heap allocation
+ *  at all: _items points at a buffer inside the object itself.  The
+ *  (N + 1)th item spills everything to the heap and from then on it grows
+ *  like any other Vector.  shrink_to_fit() brings the items back inside
+ *  once they fit again.
+ *
+ *  Copies and moves of an inline SmallArray copy or move the items into
+ *  the other object's own buffer.  A spilled one moves by stealing the
+ *  heap pointer, as Vector does.
+ *
+ */
+
+#ifndef SMALL_ARRAY_H
+#define SMALL_ARRAY_H
+#include <initializer_list>
+#include <utility>
+#include "Vector.h"
+using namespace std;
+
+template <typename T, int N>
+class SmallArray : public Vector<T>
+{
+	static_assert(N > 0, "SmallArray needs room for at least one item.");
+
+protected:
+
+	//raw space for the first N items
+	alignas(T) unsigned char _inline_items[sizeof(T) * N];
+
+	T *inlineItems()
+	{
+		return reinterpret_cast<T *>(_inline_items);
+	}
+
+	//the inline buffer is part of us, not heap storage
+	virtual bool ownsHeapItems() const
+	{
+		return this->_items != reinterpret_cast<const T *>(_inline_items);
+	}
+
+	//destroys our items and goes back to the empty inline buffer
+	void resetToInline()
+	{
+		this->releaseItems();
+		this->_items = inlineItems();
+		this->_max_size = N;
+	}
+
+	//copies count items from source, spilling first if they don't fit.
+	//We must be empty.
+	void copyItems(const T *source, int count)
+	{
+		this->reserve(count);
+		RawStorage<T>::copyConstruct(this->_items, source, count);
+		this->_number_of_items = count;
+	}
+
+	//takes over other's items; we must be empty and inline.  A spilled
+	//other hands over its heap buffer and is left empty and inline.
+	void moveItems(SmallArray<T, N> &other)
+	{
+		if (other.ownsHeapItems())
+		{
+			this->_items = other._items;
+			this->_max_size = other._max_size;
+			this->_number_of_items = other._number_of_items;
+			CONTAINER_STATS_RECORD(this->_stats.takeLive(other._stats));
+			other._items = other.inlineItems();
+			other._max_size = N;
+			other._number_of_items = 0;
+			return;
+		}
+		RawStorage<T>::moveConstruct(this->_items, other._items, other._number_of_items);
+		this->_number_of_items = other._number_of_items;
+		RawStorage<T>::destroy(other._items, other._number_of_items);
+		other._number_of_items = 0;
+	}
+
+public:
+
+#pragma region constructors / destructors
+
+	//empty array using the inline buffer
+	SmallArray()
+		: Vector<T>(0)
+	{
+		this->_items = inlineItems();
+		this->_max_size = N;
+	}
+
+	//empty array with room for capacity items; more than N spills at once
+	explicit SmallArray(int capacity)
+		: SmallArray()
+	{
+		this->reserve(capacity);
+	}
+
+	SmallArray(initializer_list<T> values)
+		: SmallArray()
+	{
+		copyItems(values.begin(), (int)values.size());
+	}
+
+	SmallArray(const SmallArray<T, N> &other)
+		: SmallArray()
+	{
+		copyItems(other._items, other._number_of_items);
+		CONTAINER_STATS_RECORD(this->_stats.copied());
+	}
+
+	SmallArray(SmallArray<T, N> &&other)
+		: SmallArray()
+	{
+		moveItems(other);
+		CONTAINER_STATS_RECORD(this->_stats.moved());
+	}
+
+	//the inline buffer must not reach ~Array, which would try to free it
+	virtual ~SmallArray()
+	{
+		this->releaseItems();
+		this->_max_size = 0;
+	}
+
+#pragma endregion
+
+#pragma region SmallArray-specific functions
+
+	//true while the items live inside the object
+	bool isInline() const
+	{
+		return !ownsHeapItems();
+	}
+
+	//number of items the object itself has room for
+	static int inlineCapacity()
+	{
+		return N;
+	}
+
+	//releases unused capacity, moving the items back inside if they fit
+	void shrink_to_fit()
+	{
+		//the inline buffer is never given up
+		if (isInline())
+		{
+			return;
+		}
+		if (this->_number_of_items > N)
+		{
+			Vector<T>::shrink_to_fit();
+			return;
+		}
+		T *heap_items = this->_items;
+		int count = this->_number_of_items;
+		RawStorage<T>::moveConstruct(inlineItems(), heap_items, count);
+		RawStorage<T>::destroy(heap_items, count);
+		this->releaseStorage(heap_items, this->_max_size);
+		this->_items = inlineItems();
+		this->_max_size = N;
+	}
+
+#pragma endregion
+
+#pragma region operator overloads
+
+	SmallArray<T, N> &operator=(const SmallArray<T, N> &other)
+	{
+		SmallArray<T, N>::operator=(static_cast<const Array<T> &>(other));
+		return *this;
+	}
+
+	SmallArray<T, N> &operator=(SmallArray<T, N> &&other)
+	{
+		if (this != &other)
+		{
+			resetToInline();
+			moveItems(other);
+			CONTAINER_STATS_RECORD(this->_stats.moved());
+		}
+		return *this;
+	}
+
+	//copies straight into the inline buffer when we're inline and other
+	//fits; otherwise builds the copy first and moves it in
+	virtual Array<T> &operator=(const Array<T> &other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		CONTAINER_STATS_RECORD(this->_stats.copied());
+		if (other.getSize() <= N && !ownsHeapItems())
+		{
+			resetToInline();
+			copyItems(other.begin(), other.getSize());
+			return *this;
+		}
+		SmallArray<T, N> copy;
+		copy.copyItems(other.begin(), other.getSize());
+		resetToInline();
+		moveItems(copy);
+		return *this;
+	}
+
+	//any Array moves in through takeItems; items that fit are moved into
+	//our own space instead
+	virtual Array<T> &operator=(Array<T> &&other)
+	{
+		if (this == &other)
+		{
+			return *this;
+		}
+		SmallArray<T, N> *small = dynamic_cast<SmallArray<T, N> *>(&other);
+		if (small != nullptr)
+		{
+			return *this = std::move(*small);
+		}
+		CONTAINER_STATS_RECORD(this->_stats.moved());
+		resetToInline();
+		if (other.getSize() <= N)
+		{
+			RawStorage<T>::moveConstruct(this->_items, other.begin(), other.getSize());
+			this->_number_of_items = other.getSize();
+			other.setSize(0);
+			return *this;
+		}
+		this->_max_size = 0;
+		this->takeItems(other);
+		return *this;
+	}
+
+#pragma endregion
+};
+
+#endif
@@ -0,0 +1,159 @@
+/*
+ * StaticIndexed.h - Compile-time dispatched algorithms over Indexed containers
+ *
+ *  Every call through an Indexed<T>& goes through the vtable, so a loop
+ *  written against the interface cannot be inlined or vectorized.  The
+ *  templates here take the container type itself as a template parameter:
+ *
+ *    - IsStaticIndexed<C> checks at compile time that C provides the
+ *      Indexed operations (getSize, isEmpty, getElementAt, ...).  Any
+ *      container qualifies, and so does Indexed<T> itself.
+ *    - The containers mark getSize, isEmpty, getElementAt and setElementAt
+ *      final, and Array's operator[] is not virtual, so those calls on a
+ *      concrete type are direct.
+ *    - When C has begin()/end() the algorithms walk iterators instead of
+ *      indexes.  For Array and Vector those are plain pointers, so the
+ *      loops vectorize; for the lists each step is O(1).
+ *
+ *  Indexed<T> stays as the runtime adapter: hand these templates an
+ *  Indexed<T>& and they still work, one virtual call per element.
+ *
+ */
+
+#ifndef STATIC_INDEXED_H
+#define STATIC_INDEXED_H
+
+#include <type_traits>
+#include <utility>
+
+using namespace std;
+
+// Element type of an Indexed-like container C
+template <typename C>
+struct IndexedValue
+{
+    typedef typename remove_const<typename remove_reference<
+        decltype(declval<const C &>().getElementAt(0))>::type>::type type;
+};
+
+// value is true when C offers the Indexed operations
+template <typename C>
+class IsStaticIndexed
+{
+    template <typename U>
+    static auto check(U *items) -> decltype(
+        (void)static_cast<int>(items->getSize()),
+        (void)static_cast<bool>(items->isEmpty()),
+        (void)items->getElementAt(0),
+        (void)static_cast<const U *>(items)->getElementAt(0),
+        (void)items->removeElementAt(0),
+        true_type());
+
+    template <typename U>
+    static false_type check(...);
+
+public:
+    static const bool value = decltype(check<C>(nullptr))::value;
+};
+
+template <typename C>
+const bool IsStaticIndexed<C>::value;
+
+// value is true when C can be walked with begin()/end()
+template <typename C>
+class HasIndexedIterators
+{
+    template <typename U>
+    static auto check(U *items) -> decltype(
+        (void)(items->begin() != items->end()),
+        true_type());
+
+    template <typename U>
+    static false_type check(...);
+
+public:
+    static const bool value = decltype(check<C>(nullptr))::value;
+};
+
+template <typename C>
+const bool HasIndexedIterators<C>::value;
+
+// Calls visit(item) on every item in order, through iterators or indexes
+template <typename C, typename F>
+void forEachElementOf(C &items, F &visit, true_type)
+{
+    for (auto it = items.begin(), end = items.end(); it != end; ++it)
+    {
+        visit(*it);
+    }
+}
+
+template <typename C, typename F>
+void forEachElementOf(C &items, F &visit, false_type)
+{
+    int size = items.getSize();
+    for (int i = 0; i < size; i++)
+    {
+        visit(items.getElementAt(i));
+    }
+}
+
+// Calls visit(item) on every item of items, in index order
+template <typename C, typename F>
+void forEachElement(C &items, F visit)
+{
+    typedef typename remove_const<C>::type Container;
+    static_assert(IsStaticIndexed<Container>::value,
+                  "forEachElement needs a container with the Indexed operations");
+    forEachElementOf(items, visit,
+                     integral_constant<bool, HasIndexedIterators<Container>::value>());
+}
+
+// Folds every item into total with operator+
+template <typename C, typename V>
+V accumulateElements(const C &items, V total)
+{
+    forEachElement(items, [&total](const typename IndexedValue<C>::type &item)
+        { total = total + item; });
+    return total;
+}
+
+template <typename C, typename V>
+int findElementOf(const C &items, const V &value, true_type)
+{
+    int index = 0;
+    for (auto it = items.begin(), end = items.end(); it != end; ++it, ++index)
+    {
+        if (*it == value)
+        {
+            return index;
+        }
+    }
+    return -1;
+}
+
+template <typename C, typename V>
+int findElementOf(const C &items, const V &value, false_type)
+{
+    int size = items.getSize();
+    for (int i = 0; i < size; i++)
+    {
+        if (items.getElementAt(i) == value)
+        {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Index of the first item equal to value, or -1
+template <typename C>
+int findElement(const C &items, const typename IndexedValue<C>::type &value)
+{
+    static_assert(IsStaticIndexed<C>::value,
+                  "findElement needs a container with the Indexed operations");
+    return findElementOf(items, value,
+                         integral_constant<bool, HasIndexedIterators<C>::value>());
+}
+
+#endif
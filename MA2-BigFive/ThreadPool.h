@@ -0,0 +1,235 @@
+/*
+ * ThreadPool.h - Reusable work-stealing pool of worker threads
+ *
+ *  Every worker owns a deque of tasks.  A worker pushes and pops its own
+ *  tasks at the back, so recently split work stays hot in its cache; a
+ *  worker that runs dry steals from the front of the others' deques,
+ *  taking the oldest (usually largest) piece of work.  Threads outside
+ *  the pool hand their tasks out round-robin.
+ *
+ *  Any thread waiting on work it gave the pool can call runPendingTask()
+ *  to help out instead of blocking, so pool tasks may themselves start
+ *  and wait on more parallel work without deadlocking.
+ *
+ *  ThreadPool::instance() is the shared pool used by ParallelAlgorithms.h.
+ *  It has one worker fewer than the machine has cores, because the
+ *  thread that starts a parallel algorithm does its share of the work.
+ *
+ */
+
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+class ThreadPool
+{
+public:
+    typedef function<void()> Task;
+
+private:
+    struct WorkQueue
+    {
+        mutex lock;
+        deque<Task> tasks;
+    };
+
+    vector<thread> _workers;
+    vector<unique_ptr<WorkQueue> > _queues;     // One per worker (at least one)
+    atomic<int> _pending;                       // Queued tasks nobody took yet
+    atomic<unsigned> _next_queue;               // Round-robin for outside submits
+    mutex _sleep_lock;
+    condition_variable _wake;
+    bool _stopping = false;                     // Guarded by _sleep_lock
+
+    // The pool and queue the calling thread works for, if any
+    static ThreadPool *&currentPool()
+    {
+        static thread_local ThreadPool *pool = nullptr;
+        return pool;
+    }
+
+    static int &currentQueue()
+    {
+        static thread_local int index = -1;
+        return index;
+    }
+
+    int callerQueue() const
+    {
+        return currentPool() == this ? currentQueue() : -1;
+    }
+
+    bool takeTask(int index, bool from_back, Task &task)
+    {
+        WorkQueue &queue = *_queues[index];
+        lock_guard<mutex> guard(queue.lock);
+        if (queue.tasks.empty())
+        {
+            return false;
+        }
+        if (from_back)
+        {
+            task = std::move(queue.tasks.back());
+            queue.tasks.pop_back();
+        }
+        else
+        {
+            task = std::move(queue.tasks.front());
+            queue.tasks.pop_front();
+        }
+        _pending.fetch_sub(1, memory_order_relaxed);
+        return true;
+    }
+
+    // Own queue first (newest task), then steal from the others (oldest)
+    bool findTask(int own, Task &task)
+    {
+        int count = (int)_queues.size();
+        if (own >= 0 && takeTask(own, true, task))
+        {
+            return true;
+        }
+        int start = own >= 0 ? own + 1 : 0;
+        for (int i = 0; i < count; i++)
+        {
+            int victim = (start + i) % count;
+            if (victim != own && takeTask(victim, false, task))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void workerLoop(int index)
+    {
+        currentPool() = this;
+        currentQueue() = index;
+        Task task;
+        while (true)
+        {
+            if (findTask(index, task))
+            {
+                task();
+                task = nullptr;
+                continue;
+            }
+            unique_lock<mutex> guard(_sleep_lock);
+            _wake.wait(guard, [this]() { return _stopping || _pending.load() > 0; });
+            if (_stopping && _pending.load() == 0)
+            {
+                return;
+            }
+        }
+    }
+
+public:
+
+    // A pool with no workers is allowed: its tasks only run when some
+    //  thread calls runPendingTask()
+    explicit ThreadPool(int workers) : _pending(0), _next_queue(0)
+    {
+        if (workers < 0)
+        {
+            throw invalid_argument("Worker count cannot be negative.");
+        }
+        for (int i = 0; i < (workers > 0 ? workers : 1); i++)
+        {
+            _queues.push_back(unique_ptr<WorkQueue>(new WorkQueue()));
+        }
+        for (int i = 0; i < workers; i++)
+        {
+            _workers.push_back(thread(&ThreadPool::workerLoop, this, i));
+        }
+    }
+
+    ThreadPool(const ThreadPool &other) = delete;
+    ThreadPool &operator=(const ThreadPool &other) = delete;
+
+    // Workers finish everything already queued before they exit
+    ~ThreadPool()
+    {
+        {
+            lock_guard<mutex> guard(_sleep_lock);
+            _stopping = true;
+        }
+        _wake.notify_all();
+        for (thread &worker : _workers)
+        {
+            worker.join();
+        }
+    }
+
+    static ThreadPool &instance()
+    {
+        static ThreadPool pool(defaultWorkerCount());
+        return pool;
+    }
+
+    // One worker per core, less the core of the thread handing out work
+    static int defaultWorkerCount()
+    {
+        int cores = (int)thread::hardware_concurrency();
+        return cores > 1 ? cores - 1 : 0;
+    }
+
+    int getWorkerCount() const
+    {
+        return (int)_workers.size();
+    }
+
+    // Threads that work on a parallel algorithm: the workers plus the caller
+    int getConcurrency() const
+    {
+        return getWorkerCount() + 1;
+    }
+
+    // Queues task to run on some worker.  Tasks must not throw.
+    void submit(Task task)
+    {
+        int index = callerQueue();
+        if (index < 0)
+        {
+            index = (int)(_next_queue.fetch_add(1, memory_order_relaxed) % _queues.size());
+        }
+        {
+            WorkQueue &queue = *_queues[index];
+            lock_guard<mutex> guard(queue.lock);
+            queue.tasks.push_back(std::move(task));
+        }
+        _pending.fetch_add(1, memory_order_relaxed);
+
+        // Taking the lock orders us with a worker about to sleep, so the
+        //  wakeup can't slip in between its check and its wait
+        {
+            lock_guard<mutex> guard(_sleep_lock);
+        }
+        _wake.notify_one();
+    }
+
+    // Runs one queued task on the calling thread.  Returns false if there
+    //  was none.
+    bool runPendingTask()
+    {
+        Task task;
+        if (!findTask(callerQueue(), task))
+        {
+            return false;
+        }
+        task();
+        return true;
+    }
+};
+
+#endif
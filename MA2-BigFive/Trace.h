@@ -0,0 +1,174 @@
+/*
+ * Trace.h - Compile-time selectable event tracing for the containers
+ *
+ *  Containers mark interesting moments (copies, moves, teardown) with
+ *  CONTAINER_TRACE_EVENT(event, object, size).  Unless the program is
+ *  built with -DCONTAINER_TRACE (make ... TRACE=1) the macro expands to
+ *  nothing, so there is no cost at all in normal builds.
+ *
+ *  When tracing is on, each event goes into TraceBuffer: a fixed-size,
+ *  lock-free ring of the most recent events.  Recording claims a slot
+ *  with one atomic increment and never blocks or does I/O; call
+ *  TraceBuffer::instance().dump(cout) whenever you want to look.
+ *
+ */
+
+#ifndef TRACE_H
+#define TRACE_H
+
+#include <atomic>
+#include <cstdint>
+#include <ostream>
+#include <vector>
+
+using namespace std;
+
+enum class TraceEvent : int
+{
+    COPY_CONSTRUCT,
+    MOVE_CONSTRUCT,
+    INITIALIZER_LIST_CONSTRUCT,
+    DESTRUCT,
+    COPY_ASSIGN,
+    MOVE_ASSIGN
+};
+
+inline const char *traceEventName(TraceEvent event)
+{
+    switch (event)
+    {
+    case TraceEvent::COPY_CONSTRUCT:             return "copy constructor";
+    case TraceEvent::MOVE_CONSTRUCT:             return "move constructor";
+    case TraceEvent::INITIALIZER_LIST_CONSTRUCT: return "initializer list constructor";
+    case TraceEvent::DESTRUCT:                   return "destructor";
+    case TraceEvent::COPY_ASSIGN:                return "copy assignment";
+    case TraceEvent::MOVE_ASSIGN:                return "move assignment";
+    }
+    return "unknown";
+}
+
+// One recorded event, as handed out by TraceBuffer::snapshot()
+struct TraceRecord
+{
+    uint64_t sequence;          // Position in the overall event stream
+    TraceEvent event;
+    const void *object;         // Container the event happened to
+    int size;                   // Its size once the operation finished
+};
+
+class TraceBuffer
+{
+public:
+    static const int CAPACITY = 4096;   // Must be a power of two
+
+private:
+    // A slot is readable when stamp == sequence + 1.  Writers store the
+    //  fields first and publish the stamp last, so a reader that sees the
+    //  stamp before and after reading the fields got a consistent record.
+    struct Slot
+    {
+        atomic<uint64_t> stamp;
+        atomic<int> event;
+        atomic<const void *> object;
+        atomic<int> size;
+    };
+
+    Slot _slots[CAPACITY];
+    atomic<uint64_t> _next;         // Sequence number of the next event
+
+    TraceBuffer()
+    {
+        clear();
+    }
+
+public:
+
+    TraceBuffer(const TraceBuffer &other) = delete;
+    TraceBuffer &operator=(const TraceBuffer &other) = delete;
+
+    static TraceBuffer &instance()
+    {
+        static TraceBuffer buffer;
+        return buffer;
+    }
+
+    // Safe to call from any thread; overwrites the oldest event when full
+    void record(TraceEvent event, const void *object, int size)
+    {
+        uint64_t sequence = _next.fetch_add(1, memory_order_relaxed);
+        Slot &slot = _slots[sequence & (CAPACITY - 1)];
+        slot.stamp.store(0, memory_order_relaxed);
+        atomic_thread_fence(memory_order_release);
+        slot.event.store((int)event, memory_order_relaxed);
+        slot.object.store(object, memory_order_relaxed);
+        slot.size.store(size, memory_order_relaxed);
+        slot.stamp.store(sequence + 1, memory_order_release);
+    }
+
+    // Total events recorded since the last clear(), including overwritten ones
+    uint64_t getRecordedCount() const
+    {
+        return _next.load(memory_order_acquire);
+    }
+
+    // The events still in the ring, oldest first.  Slots being rewritten
+    //  while we read are skipped.
+    vector<TraceRecord> snapshot() const
+    {
+        vector<TraceRecord> records;
+        uint64_t end = _next.load(memory_order_acquire);
+        uint64_t start = end > (uint64_t)CAPACITY ? end - CAPACITY : 0;
+        for (uint64_t sequence = start; sequence < end; sequence++)
+        {
+            const Slot &slot = _slots[sequence & (CAPACITY - 1)];
+            if (slot.stamp.load(memory_order_acquire) != sequence + 1)
+            {
+                continue;
+            }
+            TraceRecord record;
+            record.sequence = sequence;
+            record.event = (TraceEvent)slot.event.load(memory_order_relaxed);
+            record.object = slot.object.load(memory_order_relaxed);
+            record.size = slot.size.load(memory_order_relaxed);
+            atomic_thread_fence(memory_order_acquire);
+            if (slot.stamp.load(memory_order_relaxed) == sequence + 1)
+            {
+                records.push_back(record);
+            }
+        }
+        return records;
+    }
+
+    // Writes one line per event still in the ring
+    void dump(ostream &out) const
+    {
+        for (const TraceRecord &record : snapshot())
+        {
+            out << " [x] #" << record.sequence << " " << traceEventName(record.event)
+                << " on " << record.object << " (size " << record.size << ")\n";
+        }
+        out.flush();
+    }
+
+    // Forgets every event.  Not safe while other threads are recording.
+    void clear()
+    {
+        for (int i = 0; i < CAPACITY; i++)
+        {
+            _slots[i].stamp.store(0, memory_order_relaxed);
+            _slots[i].event.store(0, memory_order_relaxed);
+            _slots[i].object.store(nullptr, memory_order_relaxed);
+            _slots[i].size.store(0, memory_order_relaxed);
+        }
+        _next.store(0, memory_order_release);
+    }
+};
+
+#ifdef CONTAINER_TRACE
+#define CONTAINER_TRACE_EVENT(event, object, size) \
+    TraceBuffer::instance().record((event), (object), (size))
+#else
+#define CONTAINER_TRACE_EVENT(event, object, size) ((void)0)
+#endif
+
+#endif
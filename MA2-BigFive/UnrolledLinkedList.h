@@ -0,0 +1,717 @@
+/*
+ * UnrolledLinkedList.h - Linked list of small arrays
+ *
+ *  Each node holds a block of up to CAPACITY items instead of a single
+ *  value.  Blocks are sized to a few cache lines, so a scan touches mostly
+ *  contiguous memory and the list pays one pointer and one allocation per
+ *  block instead of per item.  Inserts only shift items within one block;
+ *  a full block is split in half, and a block that falls below half full
+ *  after a removal merges with a neighbour or borrows items from it, so
+ *  removals can't leave the list as a chain of nearly empty blocks.
+ *
+ */
+
+#ifndef UNROLLED_LINKED_LIST_H
+#define UNROLLED_LINKED_LIST_H
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "Indexed.h"
+#include "RawStorage.h"
+
+using namespace std;
+
+// One block of an UnrolledLinkedList.  Only items [0, _count) are live.
+template <typename T>
+class UnrolledListNode
+{
+public:
+    static const int CACHE_LINE = 64;
+    static const int BLOCK_BYTES = 4 * CACHE_LINE;
+    static const int HEADER_BYTES = (int)(sizeof(void *) + sizeof(int) * 2);
+
+    // As many items as fit in BLOCK_BYTES next to the header, but at least 4
+    static const int CAPACITY =
+        (int)(BLOCK_BYTES - HEADER_BYTES) / (int)sizeof(T) >= 4
+            ? (int)(BLOCK_BYTES - HEADER_BYTES) / (int)sizeof(T)
+            : 4;
+
+private:
+    UnrolledListNode<T> *_next = nullptr;
+    int _count = 0;
+    typename aligned_storage<sizeof(T), alignof(T)>::type _storage[CAPACITY];
+
+public:
+
+    UnrolledListNode()
+    {
+    }
+
+    UnrolledListNode(const UnrolledListNode<T> &other) = delete;
+    UnrolledListNode<T> &operator=(const UnrolledListNode<T> &other) = delete;
+
+    ~UnrolledListNode()
+    {
+        RawStorage<T>::destroy(getItems(), _count);
+    }
+
+    T *getItems()
+    {
+        return reinterpret_cast<T *>(_storage);
+    }
+
+    const T *getItems() const
+    {
+        return reinterpret_cast<const T *>(_storage);
+    }
+
+    UnrolledListNode<T> *getNext() const
+    {
+        return _next;
+    }
+
+    void setNext(UnrolledListNode<T> *next)
+    {
+        _next = next;
+    }
+
+    int getCount() const
+    {
+        return _count;
+    }
+
+    bool isFull() const
+    {
+        return _count == CAPACITY;
+    }
+
+    // Builds an item from args after the last one in this block
+    template <typename... Args>
+    void emplaceBack(Args &&... args)
+    {
+        new (getItems() + _count) T(std::forward<Args>(args)...);
+        _count++;
+    }
+
+    // Puts value at offset, shifting later items in this block right
+    void insert(T &&value, int offset)
+    {
+        T *items = getItems();
+        if (offset == _count)
+        {
+            new (items + offset) T(std::move(value));
+        }
+        else
+        {
+            RawStorage<T>::shiftRight(items, _count, offset);
+            items[offset] = std::move(value);
+        }
+        _count++;
+    }
+
+    // Removes the item at offset, shifting later items in this block left
+    void remove(int offset)
+    {
+        T *items = getItems();
+        RawStorage<T>::shiftLeft(items, _count, offset);
+        _count--;
+        items[_count].~T();
+    }
+
+    // Moves items [from, _count) to the end of other
+    void moveTailTo(UnrolledListNode<T> *other, int from)
+    {
+        int moving = _count - from;
+        RawStorage<T>::moveConstruct(other->getItems() + other->_count,
+                                     getItems() + from, moving);
+        RawStorage<T>::destroy(getItems() + from, moving);
+        other->_count += moving;
+        _count = from;
+    }
+
+    // Moves the first count items to the end of other, shifting the rest
+    //  of this block left
+    void moveHeadTo(UnrolledListNode<T> *other, int count)
+    {
+        T *items = getItems();
+        RawStorage<T>::moveConstruct(other->getItems() + other->_count, items, count);
+        other->_count += count;
+        for (int i = count; i < _count; i++)
+        {
+            items[i - count] = std::move(items[i]);
+        }
+        RawStorage<T>::destroy(items + _count - count, count);
+        _count -= count;
+    }
+
+    // Moves items [from, _count) to the front of other, shifting other's
+    //  items right to make room
+    void moveTailToFront(UnrolledListNode<T> *other, int from)
+    {
+        int moving = _count - from;
+        T *items = getItems();
+        T *theirs = other->getItems();
+        for (int i = other->_count - 1; i >= 0; i--)
+        {
+            if (i + moving >= other->_count)
+            {
+                new (theirs + i + moving) T(std::move(theirs[i]));
+            }
+            else
+            {
+                theirs[i + moving] = std::move(theirs[i]);
+            }
+        }
+        for (int i = 0; i < moving; i++)
+        {
+            if (i < other->_count)
+            {
+                theirs[i] = std::move(items[from + i]);
+            }
+            else
+            {
+                new (theirs + i) T(std::move(items[from + i]));
+            }
+        }
+        RawStorage<T>::destroy(items + from, moving);
+        other->_count += moving;
+        _count = from;
+    }
+
+    // Copies count items from source onto the end of this block
+    void append(const T *source, int count)
+    {
+        RawStorage<T>::copyConstruct(getItems() + _count, source, count);
+        _count += count;
+    }
+};
+
+
+// Forward iterator over every item of an UnrolledLinkedList
+template <typename T, bool IsConst>
+class UnrolledListIterator
+{
+public:
+    typedef forward_iterator_tag iterator_category;
+    typedef T value_type;
+    typedef ptrdiff_t difference_type;
+    typedef typename conditional<IsConst, const T *, T *>::type pointer;
+    typedef typename conditional<IsConst, const T &, T &>::type reference;
+    typedef typename conditional<IsConst, const UnrolledListNode<T>,
+                                 UnrolledListNode<T> >::type node_type;
+
+private:
+    node_type *_node;
+    int _offset;
+
+public:
+
+    UnrolledListIterator(node_type *node = nullptr, int offset = 0)
+        : _node(node), _offset(offset)
+    {
+    }
+
+    template <bool OtherConst,
+              typename = typename enable_if<IsConst && !OtherConst>::type>
+    UnrolledListIterator(const UnrolledListIterator<T, OtherConst> &other)
+        : _node(other.getNode()), _offset(other.getOffset())
+    {
+    }
+
+    node_type *getNode() const
+    {
+        return _node;
+    }
+
+    int getOffset() const
+    {
+        return _offset;
+    }
+
+    reference operator*() const
+    {
+        return _node->getItems()[_offset];
+    }
+
+    pointer operator->() const
+    {
+        return _node->getItems() + _offset;
+    }
+
+    UnrolledListIterator<T, IsConst> &operator++()
+    {
+        if (++_offset == _node->getCount())
+        {
+            _node = _node->getNext();
+            _offset = 0;
+        }
+        return *this;
+    }
+
+    UnrolledListIterator<T, IsConst> operator++(int)
+    {
+        UnrolledListIterator<T, IsConst> previous = *this;
+        ++(*this);
+        return previous;
+    }
+
+    bool operator==(const UnrolledListIterator<T, IsConst> &other) const
+    {
+        return _node == other._node && _offset == other._offset;
+    }
+
+    bool operator!=(const UnrolledListIterator<T, IsConst> &other) const
+    {
+        return !(*this == other);
+    }
+};
+
+
+template <typename T>
+class UnrolledLinkedList : public Indexed<T>
+{
+//*****************************************************************************
+private:
+    typedef UnrolledListNode<T> Node;
+
+    Node *_front = nullptr;                 // First block
+    Node *_end = nullptr;                   // Last block, for O(1) appends
+    int _size = 0;                          // Items across all blocks
+
+    Node *_last_accessed_node = nullptr;    // Block of the last lookup
+    int _last_accessed_start = 0;           // Index of its first item
+
+    // Finds the block holding index and the offset of index inside it.
+    //  Sequential lookups continue from the last block we found.
+    Node *findBlock(int index, int &offset) const
+    {
+        Node *current = _front;
+        int start = 0;
+        if (_last_accessed_node != nullptr && index >= _last_accessed_start)
+        {
+            current = _last_accessed_node;
+            start = _last_accessed_start;
+        }
+        while (index >= start + current->getCount())
+        {
+            start += current->getCount();
+            current = current->getNext();
+        }
+        offset = index - start;
+        return current;
+    }
+
+    // Same as findBlock, but walks from the front so it can also report
+    //  the block before the one found (nullptr for the first block)
+    Node *findBlockWithPrevious(int index, int &offset, Node *&previous) const
+    {
+        previous = nullptr;
+        Node *current = _front;
+        int start = 0;
+        while (index >= start + current->getCount())
+        {
+            start += current->getCount();
+            previous = current;
+            current = current->getNext();
+        }
+        offset = index - start;
+        return current;
+    }
+
+    // Splits a full block in two, returning the new second half
+    Node *splitBlock(Node *block)
+    {
+        Node *second = new Node();
+        block->moveTailTo(second, block->getCount() / 2);
+        second->setNext(block->getNext());
+        block->setNext(second);
+        if (_end == block)
+        {
+            _end = second;
+        }
+        return second;
+    }
+
+    // Unlinks and frees block; previous is the block before it
+    void unlinkBlock(Node *block, Node *previous)
+    {
+        if (previous == nullptr)
+        {
+            _front = block->getNext();
+        }
+        else
+        {
+            previous->setNext(block->getNext());
+        }
+        if (_end == block)
+        {
+            _end = previous;
+        }
+        delete block;
+    }
+
+    void forgetCursor()
+    {
+        _last_accessed_node = nullptr;
+        _last_accessed_start = 0;
+    }
+
+    void checkIndex(int index) const
+    {
+        if (index < 0 || index >= _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+    }
+
+    // Appends copies of every block of other, keeping its block layout
+    void copyBlocks(const UnrolledLinkedList<T> &other)
+    {
+        for (const Node *block = other._front; block != nullptr; block = block->getNext())
+        {
+            Node *copy = new Node();
+            try
+            {
+                copy->append(block->getItems(), block->getCount());
+            }
+            catch (...)
+            {
+                delete copy;
+                throw;
+            }
+            if (_end == nullptr)
+            {
+                _front = copy;
+            }
+            else
+            {
+                _end->setNext(copy);
+            }
+            _end = copy;
+            _size += copy->getCount();
+        }
+    }
+
+    void stealFrom(UnrolledLinkedList<T> &other)
+    {
+        _front = other._front;
+        _end = other._end;
+        _size = other._size;
+        other._front = nullptr;
+        other._end = nullptr;
+        other._size = 0;
+        other.forgetCursor();
+    }
+
+//*****************************************************************************
+public:
+    static const int BLOCK_CAPACITY = UnrolledListNode<T>::CAPACITY;
+
+    // Removals keep every block but a lone one at least this full
+    static const int MIN_BLOCK_COUNT = BLOCK_CAPACITY / 2;
+
+    typedef UnrolledListIterator<T, false> iterator;
+    typedef UnrolledListIterator<T, true> const_iterator;
+
+    UnrolledLinkedList()
+    {
+    }
+
+    UnrolledLinkedList(const UnrolledLinkedList<T> &other)
+    {
+        try
+        {
+            copyBlocks(other);
+        }
+        catch (...)
+        {
+            clear();
+            throw;
+        }
+    }
+
+    UnrolledLinkedList(UnrolledLinkedList<T> &&other)
+    {
+        stealFrom(other);
+    }
+
+    UnrolledLinkedList(initializer_list<T> values)
+    {
+        for (auto item : values)
+        {
+            addElement(item);
+        }
+    }
+
+    virtual ~UnrolledLinkedList()
+    {
+        clear();
+    }
+
+    virtual UnrolledLinkedList<T> &operator=(const UnrolledLinkedList<T> &other)
+    {
+        if (this != &other)
+        {
+            UnrolledLinkedList<T> copy{ other };
+            clear();
+            stealFrom(copy);
+        }
+        return *this;
+    }
+
+    virtual UnrolledLinkedList<T> &operator=(UnrolledLinkedList<T> &&other)
+    {
+        if (this != &other)
+        {
+            clear();
+            stealFrom(other);
+        }
+        return *this;
+    }
+
+    // Frees every block
+    void clear()
+    {
+        Node *current = _front;
+        while (current != nullptr)
+        {
+            Node *next = current->getNext();
+            delete current;
+            current = next;
+        }
+        _front = nullptr;
+        _end = nullptr;
+        _size = 0;
+        forgetCursor();
+    }
+
+    virtual bool isEmpty() const final
+    {
+        return _size == 0;
+    }
+
+    virtual int getSize() const final
+    {
+        return _size;
+    }
+
+    // Number of blocks currently allocated
+    int getBlockCount() const
+    {
+        int count = 0;
+        for (Node *block = _front; block != nullptr; block = block->getNext())
+        {
+            count++;
+        }
+        return count;
+    }
+
+    virtual void addElement(const T &value)
+    {
+        emplaceElementAt(_size, value);
+    }
+
+    virtual void addElement(T &&value)
+    {
+        emplaceElementAt(_size, std::move(value));
+    }
+
+    template <typename... Args>
+    void emplaceElement(Args &&... args)
+    {
+        emplaceElementAt(_size, std::forward<Args>(args)...);
+    }
+
+    virtual T &getElementAt(int index) final
+    {
+        checkIndex(index);
+        int offset = 0;
+        Node *block = findBlock(index, offset);
+        _last_accessed_node = block;
+        _last_accessed_start = index - offset;
+        return block->getItems()[offset];
+    }
+
+    // Note: like LinkedList, the const version cannot move the cursor
+    virtual const T &getElementAt(int index) const final
+    {
+        checkIndex(index);
+        int offset = 0;
+        Node *block = findBlock(index, offset);
+        return block->getItems()[offset];
+    }
+
+    virtual void setElementAt(const T &value, int index) final
+    {
+        getElementAt(index) = value;
+    }
+
+    virtual void setElementAt(T &&value, int index) final
+    {
+        getElementAt(index) = std::move(value);
+    }
+
+    virtual void addElementAt(const T &value, int index)
+    {
+        emplaceElementAt(index, value);
+    }
+
+    virtual void addElementAt(T &&value, int index)
+    {
+        emplaceElementAt(index, std::move(value));
+    }
+
+    // Appends construct straight into the last block's free slot
+    template <typename... Args>
+    void emplaceElementAt(int index, Args &&... args)
+    {
+        if (index < 0 || index > _size)
+        {
+            throw out_of_range("Invalid index.");
+        }
+        forgetCursor();
+
+        // Appending: fill the last block, then start a fresh one.  Blocks
+        //  built by appends stay completely full.
+        if (index == _size)
+        {
+            if (_end == nullptr || _end->isFull())
+            {
+                // Filled before it is linked in, so a throwing constructor
+                //  cannot leave an empty block behind
+                Node *block = new Node();
+                try
+                {
+                    block->emplaceBack(std::forward<Args>(args)...);
+                }
+                catch (...)
+                {
+                    delete block;
+                    throw;
+                }
+                if (_end == nullptr)
+                {
+                    _front = block;
+                }
+                else
+                {
+                    _end->setNext(block);
+                }
+                _end = block;
+            }
+            else
+            {
+                _end->emplaceBack(std::forward<Args>(args)...);
+            }
+            _size++;
+            return;
+        }
+
+        // Shifting or splitting may move the item args refer to, so build
+        //  the value before anything moves
+        T value(std::forward<Args>(args)...);
+        int offset = 0;
+        Node *block = findBlock(index, offset);
+        if (block->isFull())
+        {
+            Node *second = splitBlock(block);
+            if (offset > block->getCount())
+            {
+                offset -= block->getCount();
+                block = second;
+            }
+        }
+        block->insert(std::move(value), offset);
+        _size++;
+    }
+
+    virtual void removeElementAt(int index)
+    {
+        checkIndex(index);
+        forgetCursor();
+
+        int offset = 0;
+        Node *previous = nullptr;
+        Node *block = findBlockWithPrevious(index, offset, previous);
+        block->remove(offset);
+        _size--;
+
+        if (block->getCount() == 0)
+        {
+            unlinkBlock(block, previous);
+            return;
+        }
+
+        // Keep blocks dense: pull the next block in whenever both fit in
+        //  one.  Failing that, a block below half full borrows from a
+        //  neighbour (the previous one, for the last block) or merges with it.
+        Node *left = block;
+        Node *right = block->getNext();
+        if (right == nullptr || left->getCount() + right->getCount() > BLOCK_CAPACITY)
+        {
+            if (block->getCount() >= MIN_BLOCK_COUNT)
+            {
+                return;
+            }
+            if (right == nullptr)
+            {
+                if (previous == nullptr)
+                {
+                    return;
+                }
+                left = previous;
+                right = block;
+            }
+        }
+        if (left->getCount() + right->getCount() <= BLOCK_CAPACITY)
+        {
+            right->moveTailTo(left, 0);
+            unlinkBlock(right, left);
+        }
+        else if (left->getCount() < right->getCount())
+        {
+            right->moveHeadTo(left, (right->getCount() - left->getCount()) / 2);
+        }
+        else
+        {
+            left->moveTailToFront(right, left->getCount() - (left->getCount() - right->getCount()) / 2);
+        }
+    }
+
+    iterator begin()
+    {
+        return iterator(_front, 0);
+    }
+
+    iterator end()
+    {
+        return iterator(nullptr, 0);
+    }
+
+    const_iterator begin() const
+    {
+        return const_iterator(_front, 0);
+    }
+
+    const_iterator end() const
+    {
+        return const_iterator(nullptr, 0);
+    }
+
+    const_iterator cbegin() const
+    {
+        return begin();
+    }
+
+    const_iterator cend() const
+    {
+        return end();
+    }
+};
+
+#endif
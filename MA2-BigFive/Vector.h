@@ -0,0 +1,179 @@
+/*
+ * Vector.h - A growable Array
+ *
+ */
+
+#ifndef VECTOR_H
+#define VECTOR_H
+#include <algorithm>
+#include <stdexcept>
+#include <initializer_list>
+#include <utility>
+#include "Array.h"
+using namespace std;
+
+template <typename T>
+class Vector : public Array<T>
+{
+protected:
+
+	//smallest capacity we grow to from an empty vector
+	static const int MIN_CAPACITY = 4;
+
+	//moves our items into a fresh buffer of new_capacity slots
+	void reallocate(int new_capacity)
+	{
+		T *items = this->allocateItems(new_capacity);
+		try
+		{
+			RawStorage<T>::moveConstruct(items, this->_items, this->_number_of_items);
+		}
+		catch (...)
+		{
+			this->releaseStorage(items, new_capacity);
+			throw;
+		}
+
+		int count = this->_number_of_items;
+		this->releaseItems();
+		this->_items = items;
+		this->_number_of_items = count;
+		this->_max_size = new_capacity;
+	}
+
+	//doubling keeps appends amortized O(1)
+	void grow()
+	{
+		int new_capacity = this->_max_size * 2;
+		if (new_capacity < MIN_CAPACITY)
+		{
+			new_capacity = MIN_CAPACITY;
+		}
+		reallocate(new_capacity);
+	}
+
+public:
+
+#pragma region constructors / destructors
+
+	//empty vector; the first add allocates
+	Vector()
+		: Array<T>(0)
+	{
+	}
+
+	//empty vector with room for capacity items before it has to grow
+	Vector(int capacity)
+		: Array<T>(capacity)
+	{
+	}
+
+	Vector(initializer_list<T> values)
+		: Array<T>(values)
+	{
+	}
+
+	Vector(const Vector<T> &other)
+		: Array<T>(other)
+	{
+	}
+
+	Vector(Vector<T> &&other)
+		: Array<T>(std::move(other))
+	{
+	}
+
+#pragma endregion
+
+#pragma region Indexed overrides
+
+	//same as Array::addElementAt, except a full vector grows instead of throwing
+	virtual void addElementAt(const T &value, int location)
+	{
+		//value may be one of our items, so copy it before growing frees them
+		if (this->_number_of_items == this->_max_size)
+		{
+			addElementAt(T(value), location);
+			return;
+		}
+		Array<T>::addElementAt(value, location);
+	}
+
+	virtual void addElementAt(T &&value, int location)
+	{
+		if (location < 0 || location > this->_number_of_items)
+		{
+			throw out_of_range("Vector index out of bounds.");
+		}
+		//value may be one of our items too, so take it out before growing
+		if (this->_number_of_items == this->_max_size)
+		{
+			T moved(std::move(value));
+			grow();
+			Array<T>::addElementAt(std::move(moved), location);
+			return;
+		}
+		Array<T>::addElementAt(std::move(value), location);
+	}
+
+#pragma endregion
+
+#pragma region Vector-specific functions
+
+	//number of items we can hold before the next reallocation
+	int capacity() const
+	{
+		return this->_max_size;
+	}
+
+	//makes room for at least new_capacity items.  Never shrinks.
+	void reserve(int new_capacity)
+	{
+		if (new_capacity > this->_max_size)
+		{
+			reallocate(new_capacity);
+		}
+	}
+
+	//copies count items to the end, growing at most once.  items must not
+	//point into this vector.
+	void addElements(const T *items, int count)
+	{
+		int needed = this->_number_of_items + count;
+		if (needed > this->_max_size)
+		{
+			reserve(max(needed, this->_max_size * 2));
+		}
+		RawStorage<T>::copyConstruct(this->_items + this->_number_of_items, items, count);
+		this->_number_of_items = needed;
+	}
+
+	//releases any unused capacity
+	void shrink_to_fit()
+	{
+		if (this->_max_size > this->_number_of_items)
+		{
+			reallocate(this->_number_of_items);
+		}
+	}
+
+#pragma endregion
+
+#pragma region operator overloads
+
+	Vector<T> &operator=(const Vector<T> &other)
+	{
+		Array<T>::operator=(other);
+		return *this;
+	}
+
+	Vector<T> &operator=(Vector<T> &&other)
+	{
+		Array<T>::operator=(std::move(other));
+		return *this;
+	}
+
+#pragma endregion
+};
+
+#endif
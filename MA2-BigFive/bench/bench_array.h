@@ -0,0 +1,122 @@
+/*
+ *  Benchmarks: Array element shifting
+ *
+ *  Suites starting with array_* exercise Array insert/remove/copy paths.
+ *  array_small_build and array_small_copy create many short arrays (size
+ *  is the item count), comparing Vector with SmallArray<T, 16>.
+ */
+
+#ifndef BENCH_ARRAY_H
+#define BENCH_ARRAY_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// An int that is not trivially copyable, forcing Array's per-item path
+struct BoxedInt
+{
+    int value;
+    BoxedInt(int v = 0) : value(v) {}
+    BoxedInt(const BoxedInt &other) : value(other.value) {}
+    BoxedInt &operator=(const BoxedInt &other) { value = other.value; return *this; }
+};
+
+// Repeated insert + remove in the middle of a full-ish array
+template <typename T>
+void benchArrayMidInsert(const string &type, int size, long long ops)
+{
+    if (!benchEnabled("array_mid_insert_remove"))
+    {
+        return;
+    }
+
+    Array<T> items(size + 1);
+    for (int i = 0; i < size; i++)
+        { items.addElement(T(i)); }
+
+    double ns = benchTime([&]() {
+        for (long long i = 0; i < ops; i++)
+        {
+            items.addElementAt(T((int)i), size / 2);
+            items.removeElementAt(size / 2);
+        }
+    });
+    bench_sink += items.getSize();
+    benchReport("array_mid_insert_remove", "Array", type, size, ops, ns);
+}
+
+template <typename T>
+void benchArrayCopy(const string &type, int size, int rounds)
+{
+    if (!benchEnabled("array_copy"))
+    {
+        return;
+    }
+
+    Array<T> items(size);
+    for (int i = 0; i < size; i++)
+        { items.addElement(T(i)); }
+
+    double ns = benchTime([&]() {
+        for (int r = 0; r < rounds; r++)
+        {
+            Array<T> copy{ items };
+            bench_sink += copy.getSize();
+        }
+    });
+    benchReport("array_copy", "Array", type, size, (long long)size * rounds, ns);
+}
+
+// Builds (or copies) a short array rounds times and sums it
+template <typename C>
+void benchArraySmall(const string &name, int size, long long rounds)
+{
+    if (benchEnabled("array_small_build"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                C items;
+                for (int i = 0; i < size; i++)
+                    { items.addElement(i); }
+                bench_sink += items[size - 1];
+            }
+        });
+        benchReport("array_small_build", name, "int", size, rounds, ns);
+    }
+
+    if (benchEnabled("array_small_copy"))
+    {
+        C items;
+        for (int i = 0; i < size; i++)
+            { items.addElement(i); }
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                C copy(items);
+                bench_sink += copy[size - 1];
+            }
+        });
+        benchReport("array_small_copy", name, "int", size, rounds, ns);
+    }
+}
+
+void benchArray()
+{
+    benchArrayMidInsert<int>("int", 1000000, 200);
+    benchArrayMidInsert<BoxedInt>("BoxedInt", 1000000, 200);
+    benchArrayCopy<int>("int", 1000000, 20);
+    benchArrayCopy<BoxedInt>("BoxedInt", 1000000, 20);
+
+    const int small_sizes[] = { 4, 16, 64 };
+    for (int size : small_sizes)
+    {
+        benchArraySmall< Vector<int> >("Vector", size, 1000000);
+        benchArraySmall< SmallArray<int, 16> >("SmallArray", size, 1000000);
+    }
+}
+
+#endif
@@ -0,0 +1,123 @@
+/*
+ *  Benchmark harness for the container library
+ *
+ *  Every benchmark reports one CSV line per measurement:
+ *    suite,container,type,size,ops,ns_per_op
+ *  so results can be diffed or loaded into a spreadsheet.
+ *
+ *  Command line options (see benchConfigure):
+ *    --csv <file>        write results to file instead of stdout
+ *    --max-size <n>      skip container sizes above n
+ *    --filter <text>     only run suites whose name contains text
+ *                        (a group such as core_ runs if text starts with it)
+ */
+
+#ifndef BENCH_BASE_H
+#define BENCH_BASE_H
+
+#include <chrono>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+using namespace std;
+
+// Written to by benchmarks so the optimizer cannot drop the measured work
+static volatile long long bench_sink = 0;
+
+// Settings shared by every suite, filled in from the command line
+struct BenchConfig
+{
+    long long max_size = 10000000;
+    string filter = "";
+    ofstream csv_file;
+    ostream *out = &cout;
+};
+
+BenchConfig &benchConfig()
+{
+    static BenchConfig config;
+    return config;
+}
+
+// Returns false (and prints usage) on a bad command line
+bool benchConfigure(int argc, char *argv[])
+{
+    BenchConfig &config = benchConfig();
+    for (int i = 1; i < argc; i++)
+    {
+        bool has_value = i + 1 < argc;
+        if (!strcmp(argv[i], "--csv") && has_value)
+        {
+            config.csv_file.open(argv[++i]);
+            if (!config.csv_file)
+            {
+                cerr << "Cannot open " << argv[i] << endl;
+                return false;
+            }
+            config.out = &config.csv_file;
+        }
+        else if (!strcmp(argv[i], "--max-size") && has_value)
+        {
+            config.max_size = atoll(argv[++i]);
+        }
+        else if (!strcmp(argv[i], "--filter") && has_value)
+        {
+            config.filter = argv[++i];
+        }
+        else
+        {
+            cerr << "Usage: " << argv[0]
+                 << " [--csv file] [--max-size n] [--filter text]" << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+// True when the suite passes --filter: its name contains the filter, or
+//  it is a prefix such as "core_" that the filter starts with, so a group
+//  of suites still runs when the filter names just one of them
+bool benchEnabled(const string &suite)
+{
+    const string &filter = benchConfig().filter;
+    return suite.find(filter) != string::npos || filter.compare(0, suite.size(), suite) == 0;
+}
+
+// True when size is within --max-size
+bool benchSizeEnabled(long long size)
+{
+    return size <= benchConfig().max_size;
+}
+
+// Runs work() once and returns the elapsed wall time in nanoseconds
+template <typename Work>
+double benchTime(Work work)
+{
+    auto start = chrono::steady_clock::now();
+    work();
+    auto stop = chrono::steady_clock::now();
+    return (double)chrono::duration_cast<chrono::nanoseconds>(stop - start).count();
+}
+
+void benchHeader()
+{
+    *benchConfig().out << "suite,container,type,size,ops,ns_per_op" << endl;
+}
+
+void benchReport(const string &suite, const string &container,
+                 const string &type, long long size, long long ops,
+                 double elapsed_ns)
+{
+    if (!benchEnabled(suite))
+    {
+        return;
+    }
+    *benchConfig().out << suite << "," << container << "," << type << ","
+                       << size << "," << ops << ","
+                       << (ops > 0 ? elapsed_ns / (double)ops : 0.0) << endl;
+}
+
+#endif
@@ -0,0 +1,127 @@
+/*
+ *  Benchmarks: Array of structs vs. ColumnArray, scanning one field
+ *
+ *  Rows are 32-byte particles (x, y, z, mass, id).  The container column
+ *  is "Array" for Array<BenchParticle>, "ColumnArray" for a plain loop over
+ *  one column, and "ColumnArray+simd" for the SimdKernels.h version:
+ *    column_count_id     counts the rows with a given id
+ *    column_sum_mass     sums the mass field
+ */
+
+#ifndef BENCH_COLUMN_H
+#define BENCH_COLUMN_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+struct BenchParticle
+{
+    double x;
+    double y;
+    double z;
+    float mass;
+    int id;
+};
+
+typedef ColumnArray<BenchParticle, COLUMN_FIELD(BenchParticle, x),
+                    COLUMN_FIELD(BenchParticle, y), COLUMN_FIELD(BenchParticle, z),
+                    COLUMN_FIELD(BenchParticle, mass),
+                    COLUMN_FIELD(BenchParticle, id)> BenchParticles;
+
+void benchColumnScans(int size)
+{
+    Array<BenchParticle> rows(size);
+    BenchParticles columns;
+    columns.reserve(size);
+    for (int i = 0; i < size; i++)
+    {
+        BenchParticle particle = { i * 1.0, i * 2.0, i * 3.0, (float)(i % 10), i % 100 };
+        rows.addElement(particle);
+        columns.addElement(particle);
+    }
+    long long rounds = 1 + 20000000 / size;
+    long long ops = size * rounds;
+
+    if (benchEnabled("column_count_id"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                int matches = 0;
+                for (const BenchParticle &particle : rows)
+                    { matches += particle.id == 42; }
+                bench_sink += matches;
+            }
+        });
+        benchReport("column_count_id", "Array", "BenchParticle", size, ops, ns);
+
+        ColumnSpan<int> ids = columns.column<4>();
+        ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                int matches = 0;
+                for (int id : ids)
+                    { matches += id == 42; }
+                bench_sink += matches;
+            }
+        });
+        benchReport("column_count_id", "ColumnArray", "BenchParticle", size, ops, ns);
+
+        ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += simdCount(ids.data(), ids.getSize(), 42); }
+        });
+        benchReport("column_count_id", "ColumnArray+simd", "BenchParticle", size, ops, ns);
+    }
+
+    if (benchEnabled("column_sum_mass"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                float total = 0;
+                for (const BenchParticle &particle : rows)
+                    { total += particle.mass; }
+                bench_sink += (long long)total;
+            }
+        });
+        benchReport("column_sum_mass", "Array", "BenchParticle", size, ops, ns);
+
+        ColumnSpan<float> masses = columns.column<3>();
+        ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                float total = 0;
+                for (float mass : masses)
+                    { total += mass; }
+                bench_sink += (long long)total;
+            }
+        });
+        benchReport("column_sum_mass", "ColumnArray", "BenchParticle", size, ops, ns);
+
+        ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += (long long)simdSum(masses.data(), masses.getSize()); }
+        });
+        benchReport("column_sum_mass", "ColumnArray+simd", "BenchParticle", size, ops, ns);
+    }
+}
+
+void benchColumn()
+{
+    if (!benchEnabled("column_"))
+    {
+        return;
+    }
+    const int sizes[] = { 10000, 1000000 };
+    for (int size : sizes)
+    {
+        if (benchSizeEnabled(size))
+            { benchColumnScans(size); }
+    }
+}
+
+#endif
@@ -0,0 +1,186 @@
+/*
+ *  Benchmarks: ConcurrentQueue and ConcurrentLinkedList vs. a mutex-guarded
+ *   LinkedList
+ *
+ *  Suites starting with concurrent_* run with 1 to 64 threads; the size
+ *  column holds the thread count and ns_per_op is wall time per item
+ *  across all threads:
+ *    concurrent_append      every thread appends, then one drain into a
+ *                           LinkedList (the mutex version appends directly)
+ *    concurrent_push_pop    every thread alternates push and pop (MPMC)
+ *    concurrent_regions     every thread repeatedly updates the values in
+ *                           its own slice of one shared list
+ */
+
+#ifndef BENCH_CONCURRENT_H
+#define BENCH_CONCURRENT_H
+
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Items handled per measurement, split evenly across the threads
+static const int BENCH_CONCURRENT_ITEMS = 256000;
+
+// Length of the shared list in concurrent_regions
+static const int BENCH_CONCURRENT_LIST = 16384;
+
+// Starts threads workers running work(thread_index) and waits for them all
+template <typename Work>
+double benchThreads(int threads, Work work)
+{
+    return benchTime([&]() {
+        vector<thread> workers;
+        for (int t = 0; t < threads; t++)
+            { workers.push_back(thread(work, t)); }
+        for (auto &worker : workers)
+            { worker.join(); }
+    });
+}
+
+void benchConcurrentAppend(int threads)
+{
+    if (!benchEnabled("concurrent_append"))
+    {
+        return;
+    }
+    int per_thread = BENCH_CONCURRENT_ITEMS / threads;
+    long long items = (long long)per_thread * threads;
+
+    {
+        ConcurrentQueue<int> queue;
+        LinkedList<int> list;
+        double ns = benchThreads(threads, [&](int t) {
+            for (int i = 0; i < per_thread; i++)
+                { queue.push(t + i); }
+        });
+        ns += benchTime([&]() { queue.drainInto(list); });
+        bench_sink += list.getSize();
+        benchReport("concurrent_append", "ConcurrentQueue", "int", threads, items, ns);
+    }
+
+    {
+        mutex lock;
+        LinkedList<int> list;
+        double ns = benchThreads(threads, [&](int t) {
+            for (int i = 0; i < per_thread; i++)
+            {
+                lock_guard<mutex> guard(lock);
+                list.addElement(t + i);
+            }
+        });
+        bench_sink += list.getSize();
+        benchReport("concurrent_append", "LinkedList+mutex", "int", threads, items, ns);
+    }
+}
+
+void benchConcurrentPushPop(int threads)
+{
+    if (!benchEnabled("concurrent_push_pop"))
+    {
+        return;
+    }
+    int per_thread = BENCH_CONCURRENT_ITEMS / threads;
+    long long items = (long long)per_thread * threads;
+
+    {
+        ConcurrentQueue<int> queue;
+        atomic<long long> sink(0);
+        double ns = benchThreads(threads, [&](int t) {
+            int value = 0;
+            long long total = 0;
+            for (int i = 0; i < per_thread; i++)
+            {
+                queue.push(t + i);
+                if (queue.tryPop(value))
+                    { total += value; }
+            }
+            sink += total;
+        });
+        bench_sink += sink.load();
+        benchReport("concurrent_push_pop", "ConcurrentQueue", "int", threads, items, ns);
+    }
+
+    {
+        mutex lock;
+        LinkedList<int> list;
+        atomic<long long> sink(0);
+        double ns = benchThreads(threads, [&](int t) {
+            long long total = 0;
+            for (int i = 0; i < per_thread; i++)
+            {
+                lock_guard<mutex> guard(lock);
+                list.addElement(t + i);
+                total += list.getElementAt(0);
+                list.removeElementAt(0);
+            }
+            sink += total;
+        });
+        bench_sink += sink.load();
+        benchReport("concurrent_push_pop", "LinkedList+mutex", "int", threads, items, ns);
+    }
+}
+
+void benchConcurrentRegions(int threads)
+{
+    if (!benchEnabled("concurrent_regions") || threads > BENCH_CONCURRENT_LIST)
+    {
+        return;
+    }
+    int region = BENCH_CONCURRENT_LIST / threads;
+    int passes = BENCH_CONCURRENT_ITEMS / BENCH_CONCURRENT_LIST;
+    long long items = (long long)region * threads * passes;
+
+    {
+        ConcurrentLinkedList<int> list;
+        for (int i = 0; i < BENCH_CONCURRENT_LIST; i++)
+            { list.addElement(i); }
+        double ns = benchThreads(threads, [&](int t) {
+            for (int pass = 0; pass < passes; pass++)
+            {
+                ConcurrentLinkedList<int>::Cursor cursor(list);
+                cursor.advance(t * region);
+                for (int i = 0; i < region && cursor.next(); i++)
+                    { cursor.getValue()++; }
+            }
+        });
+        bench_sink += list.getElementAt(0);
+        benchReport("concurrent_regions", "ConcurrentLinkedList", "int", threads, items, ns);
+    }
+
+    {
+        mutex lock;
+        LinkedList<int> list;
+        for (int i = 0; i < BENCH_CONCURRENT_LIST; i++)
+            { list.addElement(i); }
+        double ns = benchThreads(threads, [&](int t) {
+            for (int pass = 0; pass < passes; pass++)
+            {
+                lock_guard<mutex> guard(lock);
+                for (int i = t * region; i < (t + 1) * region; i++)
+                    { list.getElementAt(i)++; }
+            }
+        });
+        bench_sink += list.getElementAt(0);
+        benchReport("concurrent_regions", "LinkedList+mutex", "int", threads, items, ns);
+    }
+}
+
+void benchConcurrent()
+{
+    const int thread_counts[] = { 1, 2, 4, 8, 16, 32, 64 };
+    for (int threads : thread_counts)
+    {
+        benchConcurrentAppend(threads);
+        benchConcurrentPushPop(threads);
+        benchConcurrentRegions(threads);
+    }
+}
+
+#endif
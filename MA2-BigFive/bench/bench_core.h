@@ -0,0 +1,347 @@
+/*
+ *  Benchmarks: the core operations of every Indexed container
+ *
+ *  Suites starting with core_* run the same operations on each container
+ *  and element type at sizes 10 .. 10M (trimmed by --max-size):
+ *    core_append           addElement into an empty container
+ *    core_destroy          destructor of a full container, per item
+ *    core_get_sequential   getElementAt(0 .. n-1)
+ *    core_get_random       getElementAt at random positions
+ *    core_insert_front     addElementAt(value, 0)
+ *    core_remove_front     removeElementAt(0)
+ *    core_insert_mid       addElementAt(value, n / 2)
+ *    core_remove_mid       removeElementAt(n / 2)
+ *    core_copy_construct   copy constructor, per item
+ *    core_copy_assign      copy assignment onto a same-sized container, per item
+ *    core_move_assign      move assignment
+ *
+ *  Operations that cost O(n) on a container (random access on lists,
+ *  front inserts on arrays, ...) run fewer times at large sizes so one
+ *  run stays in the minutes.  std::string payloads stop at 1M items to
+ *  keep memory in check.
+ */
+
+#ifndef BENCH_CORE_H
+#define BENCH_CORE_H
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <utility>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Element steps allowed for each O(n)-per-operation measurement
+static const long long BENCH_LINEAR_WORK = 50000000;
+
+// Upper bound on operations for the cheap (O(1) / O(log n)) measurements
+static const long long BENCH_MAX_OPS = 1000000;
+
+//*** Element types ***
+template <typename T>
+struct BenchType;
+
+template <>
+struct BenchType<int>
+{
+    static const char *name() { return "int"; }
+    static long long maxSize() { return 10000000; }
+    static int make(int i) { return i; }
+    static long long weight(const int &value) { return value; }
+};
+
+template <>
+struct BenchType<double>
+{
+    static const char *name() { return "double"; }
+    static long long maxSize() { return 10000000; }
+    static double make(int i) { return i * 0.5; }
+    static long long weight(const double &value) { return (long long)value; }
+};
+
+// Long enough to defeat the small string optimization
+template <>
+struct BenchType<string>
+{
+    static const char *name() { return "string"; }
+    static long long maxSize() { return 1000000; }
+    static string make(int i) { return "benchmark-payload-" + to_string(i); }
+    static long long weight(const string &value) { return (long long)value.size(); }
+};
+
+//*** Containers ***
+//  name:          label in the CSV
+//  linear_index:  positional access walks O(n) items
+//  linear_front:  inserting at the front shifts O(n) items
+//  make(n):       empty container with room for at least n items
+template <typename C>
+struct BenchContainer;
+
+template <typename T>
+struct BenchContainer< Array<T> >
+{
+    static const char *name() { return "Array"; }
+    static const bool linear_index = false;
+    static const bool linear_front = true;
+    static Array<T> *make(int capacity) { return new Array<T>(capacity); }
+};
+
+template <typename T>
+struct BenchContainer< Vector<T> >
+{
+    static const char *name() { return "Vector"; }
+    static const bool linear_index = false;
+    static const bool linear_front = true;
+    static Vector<T> *make(int) { return new Vector<T>(); }
+};
+
+template <typename T>
+struct BenchContainer< LinkedList<T> >
+{
+    static const char *name() { return "LinkedList"; }
+    static const bool linear_index = true;
+    static const bool linear_front = false;
+    static LinkedList<T> *make(int) { return new LinkedList<T>(); }
+};
+
+template <typename T>
+struct BenchContainer< PooledLinkedList<T> >
+{
+    static const char *name() { return "PooledLinkedList"; }
+    static const bool linear_index = true;
+    static const bool linear_front = false;
+    static PooledLinkedList<T> *make(int) { return new PooledLinkedList<T>(); }
+};
+
+template <typename T>
+struct BenchContainer< DoublyLinkedList<T> >
+{
+    static const char *name() { return "DoublyLinkedList"; }
+    static const bool linear_index = true;
+    static const bool linear_front = false;
+    static DoublyLinkedList<T> *make(int) { return new DoublyLinkedList<T>(); }
+};
+
+template <typename T>
+struct BenchContainer< UnrolledLinkedList<T> >
+{
+    static const char *name() { return "UnrolledLinkedList"; }
+    static const bool linear_index = true;
+    static const bool linear_front = false;
+    static UnrolledLinkedList<T> *make(int) { return new UnrolledLinkedList<T>(); }
+};
+
+template <typename T>
+struct BenchContainer< SkipList<T> >
+{
+    static const char *name() { return "SkipList"; }
+    static const bool linear_index = false;
+    static const bool linear_front = false;
+    static SkipList<T> *make(int) { return new SkipList<T>(); }
+};
+
+// How many times to repeat an operation on a container of size items
+long long benchOps(bool linear, long long size)
+{
+    long long ops = linear ? BENCH_LINEAR_WORK / size : size;
+    long long floor = linear ? 10 : 1000;
+    if (ops < floor)
+    {
+        ops = floor;
+    }
+    if (ops > BENCH_MAX_OPS)
+    {
+        ops = BENCH_MAX_OPS;
+    }
+    return ops;
+}
+
+template <typename C, typename T>
+C *benchFill(int size, int capacity)
+{
+    C *items = BenchContainer<C>::make(capacity);
+    for (int i = 0; i < size; i++)
+        { items->addElement(BenchType<T>::make(i)); }
+    return items;
+}
+
+// Times an insert-then-remove cycle at a position chosen by where(size),
+//  in batches so the container stays within ~10% of its starting size
+template <typename C, typename T, typename Where>
+void benchCoreInsertRemove(const string &insert_suite, const string &remove_suite,
+                           int size, long long ops, Where where)
+{
+    typedef BenchContainer<C> Info;
+    bool want_insert = benchEnabled(insert_suite);
+    bool want_remove = benchEnabled(remove_suite);
+    if (!want_insert && !want_remove)
+    {
+        return;
+    }
+
+    long long batch = size / 10 > 16 ? size / 10 : 16;
+    if (batch > ops)
+    {
+        batch = ops;
+    }
+    unique_ptr<C> items(benchFill<C, T>(size, size + (int)batch));
+    double insert_ns = 0;
+    double remove_ns = 0;
+    long long done = 0;
+    while (done < ops)
+    {
+        insert_ns += benchTime([&]() {
+            for (int i = 0; i < (int)batch; i++)
+                { items->addElementAt(BenchType<T>::make(i), where(items->getSize())); }
+        });
+        remove_ns += benchTime([&]() {
+            for (int i = 0; i < (int)batch; i++)
+                { items->removeElementAt(where(items->getSize() - 1)); }
+        });
+        done += batch;
+    }
+    benchReport(insert_suite, Info::name(), BenchType<T>::name(), size, done, insert_ns);
+    benchReport(remove_suite, Info::name(), BenchType<T>::name(), size, done, remove_ns);
+}
+
+template <typename C, typename T>
+void benchCoreContainer(int size)
+{
+    typedef BenchContainer<C> Info;
+    const string name = Info::name();
+    const string type = BenchType<T>::name();
+
+    // Whole-container passes handle size items each, so repeat small ones
+    long long rounds = 1 + 1000000 / size;
+
+    // Build and tear down
+    if (benchEnabled("core_append") || benchEnabled("core_destroy"))
+    {
+        double append_ns = 0;
+        double destroy_ns = 0;
+        for (long long r = 0; r < rounds; r++)
+        {
+            unique_ptr<C> items(Info::make(size));
+            append_ns += benchTime([&]() {
+                for (int i = 0; i < size; i++)
+                    { items->addElement(BenchType<T>::make(i)); }
+            });
+            destroy_ns += benchTime([&]() { items.reset(); });
+        }
+        benchReport("core_append", name, type, size, size * rounds, append_ns);
+        benchReport("core_destroy", name, type, size, size * rounds, destroy_ns);
+    }
+
+    unique_ptr<C> source(benchFill<C, T>(size, size));
+
+    if (benchEnabled("core_get_sequential"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                for (int i = 0; i < size; i++)
+                    { bench_sink += BenchType<T>::weight(source->getElementAt(i)); }
+            }
+        });
+        benchReport("core_get_sequential", name, type, size, size * rounds, ns);
+    }
+
+    if (benchEnabled("core_get_random"))
+    {
+        long long ops = benchOps(Info::linear_index, size);
+        uint32_t state = 2463534242u;
+        double ns = benchTime([&]() {
+            for (long long i = 0; i < ops; i++)
+            {
+                state ^= state << 13;
+                state ^= state >> 17;
+                state ^= state << 5;
+                bench_sink += BenchType<T>::weight(source->getElementAt((int)(state % (uint32_t)size)));
+            }
+        });
+        benchReport("core_get_random", name, type, size, ops, ns);
+    }
+
+    benchCoreInsertRemove<C, T>("core_insert_front", "core_remove_front", size,
+        benchOps(Info::linear_front, size), [](int) { return 0; });
+    benchCoreInsertRemove<C, T>("core_insert_mid", "core_remove_mid", size,
+        benchOps(Info::linear_index || Info::linear_front, size),
+        [](int current) { return current / 2; });
+
+    // Ping-pong the contents between two containers
+    if (benchEnabled("core_move_assign"))
+    {
+        unique_ptr<C> other(Info::make(size));
+        const long long moves = 100000;
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < moves; r += 2)
+            {
+                *other = std::move(*source);
+                *source = std::move(*other);
+            }
+        });
+        bench_sink += source->getSize();
+        benchReport("core_move_assign", name, type, size, moves, ns);
+    }
+
+    if (benchEnabled("core_copy_construct"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                C copy{ *source };
+                bench_sink += copy.getSize();
+            }
+        });
+        benchReport("core_copy_construct", name, type, size, size * rounds, ns);
+    }
+
+    if (benchEnabled("core_copy_assign"))
+    {
+        unique_ptr<C> target(benchFill<C, T>(size, size));
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                *target = *source;
+                bench_sink += target->getSize();
+            }
+        });
+        benchReport("core_copy_assign", name, type, size, size * rounds, ns);
+    }
+}
+
+template <typename T>
+void benchCoreType()
+{
+    const int sizes[] = { 10, 100, 1000, 10000, 100000, 1000000, 10000000 };
+    for (int size : sizes)
+    {
+        if (!benchSizeEnabled(size) || size > BenchType<T>::maxSize())
+        {
+            continue;
+        }
+        benchCoreContainer< Array<T>, T >(size);
+        benchCoreContainer< Vector<T>, T >(size);
+        benchCoreContainer< LinkedList<T>, T >(size);
+        benchCoreContainer< PooledLinkedList<T>, T >(size);
+        benchCoreContainer< DoublyLinkedList<T>, T >(size);
+        benchCoreContainer< UnrolledLinkedList<T>, T >(size);
+        benchCoreContainer< SkipList<T>, T >(size);
+    }
+}
+
+void benchCore()
+{
+    // Runs for an empty filter, "core", "core_", or one core_* suite name
+    if (!benchEnabled("core_"))
+    {
+        return;
+    }
+    benchCoreType<int>();
+    benchCoreType<double>();
+    benchCoreType<string>();
+}
+
+#endif
@@ -0,0 +1,73 @@
+/*
+ *  Benchmarks: DoublyLinkedList fingers vs. LinkedList's forward cursor
+ *
+ *  Suites starting with doubly_* walk indexes in orders the single
+ *  forward-only cursor handles badly
+ */
+
+#ifndef BENCH_DOUBLY_H
+#define BENCH_DOUBLY_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// getElementAt from the back to the front
+template <typename List>
+void benchDoublyBackward(const string &name, int size)
+{
+    if (!benchEnabled("doubly_backward_get"))
+    {
+        return;
+    }
+
+    List list;
+    for (int i = 0; i < size; i++)
+        { list.addElement(i); }
+
+    double ns = benchTime([&]() {
+        for (int i = size - 1; i >= 0; i--)
+            { bench_sink += list.getElementAt(i); }
+    });
+    benchReport("doubly_backward_get", name, "int", size, size, ns);
+}
+
+// Two cursors a quarter and three quarters of the way in, stepping together
+template <typename List>
+void benchDoublyTwoCursors(const string &name, int size)
+{
+    if (!benchEnabled("doubly_two_cursors_get"))
+    {
+        return;
+    }
+
+    List list;
+    for (int i = 0; i < size; i++)
+        { list.addElement(i); }
+
+    int steps = size / 4;
+    double ns = benchTime([&]() {
+        for (int i = 0; i < steps; i++)
+        {
+            bench_sink += list.getElementAt(size / 4 + i);
+            bench_sink += list.getElementAt(3 * size / 4 - i);
+        }
+    });
+    benchReport("doubly_two_cursors_get", name, "int", size, 2LL * steps, ns);
+}
+
+void benchDoubly()
+{
+    const int sizes[] = { 1000, 20000 };
+    for (int size : sizes)
+    {
+        benchDoublyBackward< LinkedList<int> >("LinkedList", size);
+        benchDoublyBackward< DoublyLinkedList<int> >("DoublyLinkedList", size);
+        benchDoublyTwoCursors< LinkedList<int> >("LinkedList", size);
+        benchDoublyTwoCursors< DoublyLinkedList<int> >("DoublyLinkedList", size);
+    }
+}
+
+#endif
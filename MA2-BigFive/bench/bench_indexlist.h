@@ -0,0 +1,135 @@
+/*
+ *  Benchmarks: IndexLinkedList's one buffer vs. a heap node per item
+ *
+ *  Suites starting with index_list_* build, walk and copy the same list of
+ *  ints as LinkedList, PooledLinkedList and IndexLinkedList.  index_list_walk
+ *  also walks an IndexLinkedList scattered by random inserts, before and
+ *  after compact().
+ */
+
+#ifndef BENCH_INDEX_LIST_H
+#define BENCH_INDEX_LIST_H
+
+#include <cstdlib>
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+template <typename List>
+void benchIndexListBuild(const string &name, int size)
+{
+    if (!benchEnabled("index_list_build"))
+    {
+        return;
+    }
+
+    double ns = benchTime([&]() {
+        List list;
+        for (int i = 0; i < size; i++)
+            { list.addElement(i); }
+        bench_sink += list.getSize();
+    });
+    benchReport("index_list_build", name, "int", size, size, ns);
+}
+
+template <typename List>
+void benchIndexListWalkOnce(const string &name, List &list, int rounds)
+{
+    double ns = benchTime([&]() {
+        for (int r = 0; r < rounds; r++)
+        {
+            for (int value : list)
+                { bench_sink += value; }
+        }
+    });
+    benchReport("index_list_walk", name, "int", list.getSize(),
+                (long long)list.getSize() * rounds, ns);
+}
+
+template <typename List>
+void benchIndexListWalk(const string &name, int size, int rounds)
+{
+    if (!benchEnabled("index_list_walk"))
+    {
+        return;
+    }
+
+    List list;
+    for (int i = 0; i < size; i++)
+        { list.addElement(i); }
+    benchIndexListWalkOnce(name, list, rounds);
+}
+
+// Inserting at random places leaves list order unrelated to buffer order
+void benchIndexListWalkScattered(int size, int rounds)
+{
+    if (!benchEnabled("index_list_walk"))
+    {
+        return;
+    }
+
+    IndexLinkedList<int> list;
+    srand(24);
+    list.addElement(0);
+    for (int i = 1; i < size; i++)
+        { list.addElementAt(i, rand() % (list.getSize() + 1)); }
+    benchIndexListWalkOnce("IndexLinkedList (scattered)", list, rounds);
+    list.compact();
+    benchIndexListWalkOnce("IndexLinkedList (compacted)", list, rounds);
+}
+
+template <typename List>
+void benchIndexListCopy(const string &name, int size, int rounds)
+{
+    if (!benchEnabled("index_list_copy"))
+    {
+        return;
+    }
+
+    List list;
+    for (int i = 0; i < size; i++)
+        { list.addElement(i); }
+
+    double ns = benchTime([&]() {
+        for (int r = 0; r < rounds; r++)
+        {
+            List copy{ list };
+            bench_sink += copy.getSize();
+        }
+    });
+    benchReport("index_list_copy", name, "int", size, (long long)size * rounds, ns);
+}
+
+void benchIndexList()
+{
+    if (!benchEnabled("index_list_"))
+    {
+        return;
+    }
+    const int sizes[] = { 1000, 100000, 1000000 };
+    for (int size : sizes)
+    {
+        if (!benchSizeEnabled(size))
+        {
+            continue;
+        }
+        int rounds = 10000000 / size;
+        benchIndexListBuild< LinkedList<int> >("LinkedList", size);
+        benchIndexListBuild< PooledLinkedList<int> >("PooledLinkedList", size);
+        benchIndexListBuild< IndexLinkedList<int> >("IndexLinkedList", size);
+        benchIndexListWalk< LinkedList<int> >("LinkedList", size, rounds);
+        benchIndexListWalk< PooledLinkedList<int> >("PooledLinkedList", size, rounds);
+        benchIndexListWalk< IndexLinkedList<int> >("IndexLinkedList", size, rounds);
+        if (size <= 100000)
+        {
+            benchIndexListWalkScattered(size, rounds);
+        }
+        benchIndexListCopy< LinkedList<int> >("LinkedList", size, rounds / 10 + 1);
+        benchIndexListCopy< PooledLinkedList<int> >("PooledLinkedList", size, rounds / 10 + 1);
+        benchIndexListCopy< IndexLinkedList<int> >("IndexLinkedList", size, rounds / 10 + 1);
+    }
+}
+
+#endif
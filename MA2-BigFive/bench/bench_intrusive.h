@@ -0,0 +1,148 @@
+/*
+ *  Benchmarks: IntrusiveList vs. lists that copy items into their own nodes
+ *
+ *  Suites starting with intrusive_* use 64-byte records that already live
+ *  in a Vector.  intrusive_churn cycles a queue of records front to back.
+ *  intrusive_touch moves a record from the middle to the back, LRU-style:
+ *  the intrusive list removes it by reference, the others must find it by
+ *  index first.
+ */
+
+#ifndef BENCH_INTRUSIVE_H
+#define BENCH_INTRUSIVE_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+struct BenchRecord : IntrusiveListHook<>
+{
+    long long id = 0;
+    char payload[40] = {};
+};
+
+void benchIntrusiveChurn(int size, long long ops)
+{
+    if (!benchEnabled("intrusive_churn"))
+    {
+        return;
+    }
+
+    Vector<BenchRecord> records(size);
+    records.setSize(size);
+    for (int i = 0; i < size; i++)
+        { records[i].id = i; }
+
+    {
+        LinkedList<BenchRecord> queue;
+        for (int i = 0; i < size; i++)
+            { queue.addElement(records[i]); }
+        double ns = benchTime([&]() {
+            for (long long i = 0; i < ops; i++)
+            {
+                BenchRecord record = queue.getElementAt(0);
+                queue.removeElementAt(0);
+                queue.addElement(record);
+            }
+        });
+        bench_sink += queue.getElementAt(0).id;
+        benchReport("intrusive_churn", "LinkedList", "record", size, ops, ns);
+    }
+
+    {
+        PooledLinkedList<BenchRecord> queue;
+        for (int i = 0; i < size; i++)
+            { queue.addElement(records[i]); }
+        double ns = benchTime([&]() {
+            for (long long i = 0; i < ops; i++)
+            {
+                BenchRecord record = queue.getElementAt(0);
+                queue.removeElementAt(0);
+                queue.addElement(record);
+            }
+        });
+        bench_sink += queue.getElementAt(0).id;
+        benchReport("intrusive_churn", "PooledLinkedList", "record", size, ops, ns);
+    }
+
+    {
+        IntrusiveList<BenchRecord> queue;
+        for (int i = 0; i < size; i++)
+            { queue.addBack(records[i]); }
+        double ns = benchTime([&]() {
+            for (long long i = 0; i < ops; i++)
+                { queue.addBack(queue.removeFront()); }
+        });
+        bench_sink += queue.getFront().id;
+        benchReport("intrusive_churn", "IntrusiveList", "record", size, ops, ns);
+        queue.clear();
+    }
+}
+
+void benchIntrusiveTouch(int size, long long ops)
+{
+    if (!benchEnabled("intrusive_touch"))
+    {
+        return;
+    }
+
+    Vector<BenchRecord> records(size);
+    records.setSize(size);
+    for (int i = 0; i < size; i++)
+        { records[i].id = i; }
+
+    {
+        DoublyLinkedList<BenchRecord> lru;
+        for (int i = 0; i < size; i++)
+            { lru.addElement(records[i]); }
+        double ns = benchTime([&]() {
+            for (long long i = 0; i < ops; i++)
+            {
+                BenchRecord record = lru.getElementAt(size / 2);
+                lru.removeElementAt(size / 2);
+                lru.addElement(record);
+            }
+        });
+        bench_sink += lru.getElementAt(0).id;
+        benchReport("intrusive_touch", "DoublyLinkedList", "record", size, ops, ns);
+    }
+
+    {
+        IntrusiveList<BenchRecord> lru;
+        for (int i = 0; i < size; i++)
+            { lru.addBack(records[i]); }
+        long long stride = size / 2 + 1;
+        double ns = benchTime([&]() {
+            for (long long i = 0; i < ops; i++)
+            {
+                BenchRecord &record = records[(int)(i * stride % size)];
+                lru.remove(record);
+                lru.addBack(record);
+            }
+        });
+        bench_sink += lru.getFront().id;
+        benchReport("intrusive_touch", "IntrusiveList", "record", size, ops, ns);
+        lru.clear();
+    }
+}
+
+void benchIntrusive()
+{
+    if (!benchEnabled("intrusive_"))
+    {
+        return;
+    }
+    const int sizes[] = { 1000, 100000 };
+    for (int size : sizes)
+    {
+        if (benchSizeEnabled(size))
+        {
+            benchIntrusiveChurn(size, 1000000);
+            benchIntrusiveTouch(size, size >= 100000 ? 2000 : 100000);
+        }
+    }
+}
+
+#endif
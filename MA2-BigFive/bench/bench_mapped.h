@@ -0,0 +1,125 @@
+/*
+ *  Benchmarks: loading and appending doubles, from text vs. a mapped file
+ *
+ *  mapped_load times getting size doubles back from disk and summing them:
+ *  "text+Vector" parses a text dump with addElement per item, "MappedArray"
+ *  opens the array file and sums through the mapping.  mapped_open times
+ *  the open alone.  mapped_append compares addElement on a Vector with a
+ *  MappedArray that grows its file.  The files are in the page cache, so
+ *  this is the warm-start case.
+ */
+
+#ifndef BENCH_MAPPED_H
+#define BENCH_MAPPED_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+const string BENCH_MAPPED_PATH = "/tmp/ma2_bench_mapped.bin";
+const string BENCH_TEXT_PATH = "/tmp/ma2_bench_mapped.txt";
+
+void benchMappedLoad(int size)
+{
+    {
+        remove(BENCH_MAPPED_PATH.c_str());
+        MappedArray<double> numbers(BENCH_MAPPED_PATH);
+        numbers.reserve(size);
+        ofstream text(BENCH_TEXT_PATH);
+        for (int i = 0; i < size; i++)
+        {
+            numbers.addElement(i * 0.25);
+            text << i * 0.25 << '\n';
+        }
+    }
+
+    if (benchEnabled("mapped_load"))
+    {
+        double ns = benchTime([&]() {
+            ifstream text(BENCH_TEXT_PATH);
+            Vector<double> numbers;
+            double value;
+            while (text >> value)
+                { numbers.addElement(value); }
+            double total = 0;
+            for (double number : numbers)
+                { total += number; }
+            bench_sink += (long long)total;
+        });
+        benchReport("mapped_load", "text+Vector", "double", size, size, ns);
+
+        ns = benchTime([&]() {
+            MappedArray<double> numbers(BENCH_MAPPED_PATH, MAPPED_READ_ONLY);
+            double total = 0;
+            for (double number : numbers)
+                { total += number; }
+            bench_sink += (long long)total;
+        });
+        benchReport("mapped_load", "MappedArray", "double", size, size, ns);
+    }
+
+    if (benchEnabled("mapped_open"))
+    {
+        const int rounds = 100;
+        double ns = benchTime([&]() {
+            for (int r = 0; r < rounds; r++)
+            {
+                MappedArray<double> numbers(BENCH_MAPPED_PATH, MAPPED_READ_ONLY);
+                bench_sink += numbers.getSize();
+            }
+        });
+        benchReport("mapped_open", "MappedArray", "double", size, rounds, ns);
+    }
+
+    remove(BENCH_MAPPED_PATH.c_str());
+    remove(BENCH_TEXT_PATH.c_str());
+}
+
+void benchMappedAppend(int size)
+{
+    if (!benchEnabled("mapped_append"))
+    {
+        return;
+    }
+
+    double ns = benchTime([&]() {
+        Vector<double> numbers;
+        for (int i = 0; i < size; i++)
+            { numbers.addElement(i * 0.25); }
+        bench_sink += numbers.getSize();
+    });
+    benchReport("mapped_append", "Vector", "double", size, size, ns);
+
+    remove(BENCH_MAPPED_PATH.c_str());
+    ns = benchTime([&]() {
+        MappedArray<double> numbers(BENCH_MAPPED_PATH);
+        for (int i = 0; i < size; i++)
+            { numbers.addElement(i * 0.25); }
+        bench_sink += numbers.getSize();
+    });
+    benchReport("mapped_append", "MappedArray", "double", size, size, ns);
+    remove(BENCH_MAPPED_PATH.c_str());
+}
+
+void benchMapped()
+{
+    if (!benchEnabled("mapped_"))
+    {
+        return;
+    }
+    const int sizes[] = { 100000, 10000000 };
+    for (int size : sizes)
+    {
+        if (benchSizeEnabled(size))
+        {
+            benchMappedLoad(size);
+            benchMappedAppend(size);
+        }
+    }
+}
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ *  Benchmarks: parallel algorithms over Array<double> on 1 to N threads
+ *
+ *  Suites starting with parallel_* run on pools of 0 up to one worker per
+ *  core (plus the calling thread); the size column holds the number of
+ *  threads working and ns_per_op is wall time per item:
+ *    parallel_for_each      scales every item in place
+ *    parallel_transform     writes the square root of every item elsewhere
+ *    parallel_reduce        sums every item (container "serial" is a plain
+ *                           loop, "deterministic" the ordered reduction)
+ *    parallel_chunk         the parallel sum on all cores with chunk sizes
+ *                           from 1K to 1M items; here size is the chunk size
+ */
+
+#ifndef BENCH_PARALLEL_H
+#define BENCH_PARALLEL_H
+
+#include <cmath>
+#include <string>
+#include <thread>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Items in the array; --max-size lowers it
+static const long long BENCH_PARALLEL_ITEMS = 8000000;
+
+void benchParallelThreads(Array<double> &items, Array<double> &out, int workers)
+{
+    ThreadPool pool(workers);
+    ParallelOptions options;
+    options.pool = &pool;
+    int threads = pool.getConcurrency();
+    int size = items.getSize();
+    auto add = [](double sum, double item) { return sum + item; };
+
+    if (benchEnabled("parallel_for_each"))
+    {
+        double ns = benchTime([&]() {
+            parallelForEach(items, [](double &item) { item *= 1.000001; }, options);
+        });
+        benchReport("parallel_for_each", "Array", "double", threads, size, ns);
+    }
+
+    if (benchEnabled("parallel_transform"))
+    {
+        double ns = benchTime([&]() {
+            parallelTransform(items, out, [](double item) { return sqrt(item); }, options);
+        });
+        bench_sink += (long long)out[size - 1];
+        benchReport("parallel_transform", "Array", "double", threads, size, ns);
+    }
+
+    if (benchEnabled("parallel_reduce"))
+    {
+        if (workers == 0)
+        {
+            double ns = benchTime([&]() {
+                double total = 0;
+                for (double item : items)
+                    { total += item; }
+                bench_sink += (long long)total;
+            });
+            benchReport("parallel_reduce", "serial", "double", threads, size, ns);
+        }
+
+        double ns = benchTime([&]() {
+            bench_sink += (long long)parallelReduce(items, 0.0, add, options);
+        });
+        benchReport("parallel_reduce", "Array", "double", threads, size, ns);
+
+        options.deterministic = true;
+        ns = benchTime([&]() {
+            bench_sink += (long long)parallelReduce(items, 0.0, add, options);
+        });
+        options.deterministic = false;
+        benchReport("parallel_reduce", "deterministic", "double", threads, size, ns);
+    }
+}
+
+void benchParallelChunks(Array<double> &items)
+{
+    if (!benchEnabled("parallel_chunk"))
+    {
+        return;
+    }
+    ParallelOptions options;
+    auto add = [](double sum, double item) { return sum + item; };
+    for (int chunk = 1024; chunk <= 1024 * 1024; chunk *= 4)
+    {
+        options.chunk_size = chunk;
+        double ns = benchTime([&]() {
+            bench_sink += (long long)parallelReduce(items, 0.0, add, options);
+        });
+        benchReport("parallel_chunk", "Array", "double", chunk, items.getSize(), ns);
+    }
+}
+
+void benchParallel()
+{
+    if (!benchEnabled("parallel_"))
+    {
+        return;
+    }
+    int size = (int)min(BENCH_PARALLEL_ITEMS, benchConfig().max_size);
+    Array<double> items(size);
+    Array<double> out(size);
+    items.setSize(size);
+    out.setSize(size);
+    for (int i = 0; i < size; i++)
+        { items[i] = i + 0.5; }
+
+    // 1, 2, 4, ... threads, and always the full machine
+    int cores = ThreadPool::defaultWorkerCount() + 1;
+    for (int threads = 1; threads < cores; threads *= 2)
+        { benchParallelThreads(items, out, threads - 1); }
+    benchParallelThreads(items, out, cores - 1);
+    benchParallelChunks(items);
+}
+
+#endif
@@ -0,0 +1,76 @@
+/*
+ *  Benchmarks: pooled node allocation vs. global new/delete
+ *
+ *  Suites starting with pool_* compare LinkedList against PooledLinkedList
+ */
+
+#ifndef BENCH_POOL_H
+#define BENCH_POOL_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Steady-state queue churn: pop the front, push the back
+template <typename List>
+void benchPoolChurn(const string &name, int size, long long ops)
+{
+    if (!benchEnabled("pool_churn"))
+    {
+        return;
+    }
+
+    List queue;
+    for (int i = 0; i < size; i++)
+        { queue.addElement(i); }
+
+    double ns = benchTime([&]() {
+        for (long long i = 0; i < ops; i++)
+        {
+            bench_sink += queue.getElementAt(0);
+            queue.removeElementAt(0);
+            queue.addElement((int)i);
+        }
+    });
+    benchReport("pool_churn", name, "int", size, ops, ns);
+}
+
+// Build a list from scratch and tear it down again
+template <typename List>
+void benchPoolBuildDestroy(const string &name, int size, int rounds)
+{
+    if (!benchEnabled("pool_build_destroy"))
+    {
+        return;
+    }
+
+    double ns = benchTime([&]() {
+        for (int r = 0; r < rounds; r++)
+        {
+            List list;
+            for (int i = 0; i < size; i++)
+                { list.addElement(i); }
+            bench_sink += list.getSize();
+        }
+    });
+    benchReport("pool_build_destroy", name, "int", size,
+                (long long)size * rounds, ns);
+}
+
+void benchPool()
+{
+    const int sizes[] = { 10, 1000, 100000 };
+    for (int size : sizes)
+    {
+        benchPoolChurn< LinkedList<int> >("LinkedList", size, 1000000);
+        benchPoolChurn< PooledLinkedList<int> >("PooledLinkedList", size, 1000000);
+
+        int rounds = 1000000 / size;
+        benchPoolBuildDestroy< LinkedList<int> >("LinkedList", size, rounds);
+        benchPoolBuildDestroy< PooledLinkedList<int> >("PooledLinkedList", size, rounds);
+    }
+}
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ *  Benchmarks: saving and loading containers (Serialize.h)
+ *
+ *  Files go to /tmp and stay in the page cache, so these measure the
+ *  format and the container work rather than the disk:
+ *    serialize_save      saveArray / saveList to an ofstream
+ *    serialize_load      loadVector / loadList / loadPooledList from an
+ *                        ifstream, and opening the same file as a read-only
+ *                        MappedArray; each load also sums the items
+ */
+
+#ifndef BENCH_SERIALIZE_H
+#define BENCH_SERIALIZE_H
+
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+const string BENCH_SERIALIZE_PATH = "/tmp/ma2_bench_serialize.bin";
+
+template <typename Container>
+void benchSerializeSum(const Container &items)
+{
+    long long total = 0;
+    for (int item : items)
+        { total += item; }
+    bench_sink += total;
+}
+
+void benchSerializeSave(int size)
+{
+    Vector<int> array(size);
+    LinkedList<int> list;
+    for (int i = 0; i < size; i++)
+    {
+        array.addElement(i);
+        list.addElement(i);
+    }
+
+    double ns = benchTime([&]() {
+        ofstream out(BENCH_SERIALIZE_PATH, ios::binary);
+        saveArray(out, array);
+    });
+    benchReport("serialize_save", "Vector", "int", size, size, ns);
+
+    ns = benchTime([&]() {
+        ofstream out(BENCH_SERIALIZE_PATH, ios::binary);
+        saveList(out, list);
+    });
+    benchReport("serialize_save", "LinkedList", "int", size, size, ns);
+}
+
+void benchSerializeLoad(int size)
+{
+    {
+        Vector<int> array(size);
+        for (int i = 0; i < size; i++)
+            { array.addElement(i); }
+        ofstream out(BENCH_SERIALIZE_PATH, ios::binary);
+        saveArray(out, array);
+    }
+
+    double ns = benchTime([&]() {
+        ifstream in(BENCH_SERIALIZE_PATH, ios::binary);
+        benchSerializeSum(loadVector<int>(in));
+    });
+    benchReport("serialize_load", "Vector", "int", size, size, ns);
+
+    ns = benchTime([&]() {
+        ifstream in(BENCH_SERIALIZE_PATH, ios::binary);
+        benchSerializeSum(loadList<int>(in));
+    });
+    benchReport("serialize_load", "LinkedList", "int", size, size, ns);
+
+    ns = benchTime([&]() {
+        ifstream in(BENCH_SERIALIZE_PATH, ios::binary);
+        benchSerializeSum(loadPooledList<int>(in));
+    });
+    benchReport("serialize_load", "PooledLinkedList", "int", size, size, ns);
+
+    ns = benchTime([&]() {
+        benchSerializeSum(MappedArray<int>(BENCH_SERIALIZE_PATH, MAPPED_READ_ONLY));
+    });
+    benchReport("serialize_load", "MappedArray", "int", size, size, ns);
+}
+
+void benchSerialize()
+{
+    if (!benchEnabled("serialize_"))
+    {
+        return;
+    }
+    const int sizes[] = { 10000, 1000000 };
+    for (int size : sizes)
+    {
+        if (!benchSizeEnabled(size))
+        {
+            continue;
+        }
+        if (benchEnabled("serialize_save"))
+            { benchSerializeSave(size); }
+        if (benchEnabled("serialize_load"))
+            { benchSerializeLoad(size); }
+    }
+    remove(BENCH_SERIALIZE_PATH.c_str());
+}
+
+#endif
@@ -0,0 +1,173 @@
+/*
+ *  Benchmarks: vectorized kernels vs. a loop over the virtual getElementAt
+ *
+ *  Suites starting with simd_* run each kernel over an Array of int, float
+ *  and double at every level the machine supports.  The container column
+ *  names the level ("scalar", "sse2", "avx2", "avx512"), or "virtual" for
+ *  the loop through an Indexed<T>&:
+ *    simd_find       searches for a value that is not there
+ *    simd_count      counts the items equal to a value
+ *    simd_sum        sums every item
+ *    simd_dot        dot product of two arrays
+ *    simd_minmax     index of the smallest and of the largest item
+ *    simd_fill       overwrites every item
+ */
+
+#ifndef BENCH_SIMD_H
+#define BENCH_SIMD_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Kept out of line so the compiler cannot see the dynamic type
+template <typename T>
+__attribute__((noinline))
+int benchSimdVirtualFind(Indexed<T> &items, T value)
+{
+    for (int i = 0; i < items.getSize(); i++)
+    {
+        if (items.getElementAt(i) == value)
+            { return i; }
+    }
+    return -1;
+}
+
+template <typename T>
+__attribute__((noinline))
+double benchSimdVirtualSum(Indexed<T> &items)
+{
+    double total = 0;
+    for (int i = 0; i < items.getSize(); i++)
+        { total += items.getElementAt(i); }
+    return total;
+}
+
+// Times every kernel at the current level; name is the level name
+template <typename T>
+void benchSimdKernels(const string &name, const string &type,
+                      Array<T> &items, Array<T> &other, long long rounds)
+{
+    int size = items.getSize();
+    long long ops = size * rounds;
+    T missing = (T)-1;
+
+    if (benchEnabled("simd_find"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += simdFind(items, missing); }
+        });
+        benchReport("simd_find", name, type, size, ops, ns);
+    }
+
+    if (benchEnabled("simd_count"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += simdCount(items, (T)3); }
+        });
+        benchReport("simd_count", name, type, size, ops, ns);
+    }
+
+    if (benchEnabled("simd_sum"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += (long long)simdSum(items); }
+        });
+        benchReport("simd_sum", name, type, size, ops, ns);
+    }
+
+    if (benchEnabled("simd_dot"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += (long long)simdDot(items, other); }
+        });
+        benchReport("simd_dot", name, type, size, ops, ns);
+    }
+
+    if (benchEnabled("simd_minmax"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += simdMinIndex(items) + simdMaxIndex(items); }
+        });
+        benchReport("simd_minmax", name, type, size, ops, ns);
+    }
+
+    if (benchEnabled("simd_fill"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { simdFill(other, (T)r); }
+        });
+        bench_sink += (long long)other[size - 1];
+        benchReport("simd_fill", name, type, size, ops, ns);
+    }
+}
+
+template <typename T>
+void benchSimdType(const string &type, int size)
+{
+    Array<T> items(size);
+    Array<T> other(size);
+    items.setSize(size);
+    other.setSize(size);
+    for (int i = 0; i < size; i++)
+    {
+        items[i] = (T)(i % 1000);
+        other[i] = (T)(i % 7);
+    }
+    long long rounds = 1 + 20000000 / size;
+
+    if (benchEnabled("simd_find"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += benchSimdVirtualFind<T>(items, (T)-1); }
+        });
+        benchReport("simd_find", "virtual", type, size, size * rounds, ns);
+    }
+
+    if (benchEnabled("simd_sum"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += (long long)benchSimdVirtualSum<T>(items); }
+        });
+        benchReport("simd_sum", "virtual", type, size, size * rounds, ns);
+    }
+
+    SimdLevel best = simdSupportedLevel();
+    for (int level = SIMD_SCALAR; level <= best; level++)
+    {
+        simdSetLevel((SimdLevel)level);
+        benchSimdKernels(simdLevelName((SimdLevel)level), type, items, other, rounds);
+    }
+    simdSetLevel(best);
+}
+
+void benchSimd()
+{
+    if (!benchEnabled("simd_"))
+    {
+        return;
+    }
+    const int sizes[] = { 1000, 100000 };
+    for (int size : sizes)
+    {
+        if (!benchSizeEnabled(size))
+        {
+            continue;
+        }
+        benchSimdType<int>("int", size);
+        benchSimdType<float>("float", size);
+        benchSimdType<double>("double", size);
+    }
+}
+
+#endif
@@ -0,0 +1,87 @@
+/*
+ *  Benchmarks: indexable SkipList vs. LinkedList's cursor heuristic
+ *
+ *  Suites starting with skiplist_* use random positions, which defeat
+ *  LinkedList's forward-only last-accessed cursor
+ */
+
+#ifndef BENCH_SKIPLIST_H
+#define BENCH_SKIPLIST_H
+
+#include <cstdint>
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Small deterministic generator so every container sees the same positions
+static uint32_t benchRandom(uint32_t &state)
+{
+    state ^= state << 13;
+    state ^= state >> 17;
+    state ^= state << 5;
+    return state;
+}
+
+template <typename List>
+void benchSkipListRandomGet(const string &name, int size, long long ops)
+{
+    if (!benchEnabled("skiplist_random_get"))
+    {
+        return;
+    }
+
+    List list;
+    for (int i = 0; i < size; i++)
+        { list.addElement(i); }
+
+    uint32_t state = 12345;
+    double ns = benchTime([&]() {
+        for (long long i = 0; i < ops; i++)
+        {
+            bench_sink += list.getElementAt((int)(benchRandom(state) % (uint32_t)size));
+        }
+    });
+    benchReport("skiplist_random_get", name, "int", size, ops, ns);
+}
+
+template <typename List>
+void benchSkipListRandomInsertRemove(const string &name, int size, long long ops)
+{
+    if (!benchEnabled("skiplist_random_insert_remove"))
+    {
+        return;
+    }
+
+    List list;
+    for (int i = 0; i < size; i++)
+        { list.addElement(i); }
+
+    uint32_t state = 54321;
+    double ns = benchTime([&]() {
+        for (long long i = 0; i < ops; i++)
+        {
+            list.addElementAt((int)i, (int)(benchRandom(state) % (uint32_t)size));
+            list.removeElementAt((int)(benchRandom(state) % (uint32_t)size));
+        }
+    });
+    bench_sink += list.getSize();
+    benchReport("skiplist_random_insert_remove", name, "int", size, ops, ns);
+}
+
+void benchSkipList()
+{
+    const int sizes[] = { 1000, 100000 };
+    for (int size : sizes)
+    {
+        // LinkedList is O(n) per random access, so it gets fewer operations
+        long long list_ops = 200000000LL / size;
+        benchSkipListRandomGet< LinkedList<int> >("LinkedList", size, list_ops);
+        benchSkipListRandomGet< SkipList<int> >("SkipList", size, 1000000);
+        benchSkipListRandomInsertRemove< LinkedList<int> >("LinkedList", size, list_ops / 2);
+        benchSkipListRandomInsertRemove< SkipList<int> >("SkipList", size, 500000);
+    }
+}
+
+#endif
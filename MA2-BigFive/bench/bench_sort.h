@@ -0,0 +1,82 @@
+/*
+ *  Benchmarks: LinkedList::sort vs. copying out to a std::vector
+ *
+ *  Suites starting with sort_* sort a LinkedList<int> of random values;
+ *  ns_per_op is time per item.  The container column is the approach:
+ *    LinkedList    in-place merge sort that relinks the nodes
+ *    copy_out      copy into a vector, std::stable_sort, rebuild the list
+ *  sort_list_random starts from shuffled values, sort_list_sorted from
+ *  values that are already in order.
+ */
+
+#ifndef BENCH_SORT_H
+#define BENCH_SORT_H
+
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Sorts a fresh copy of source rounds times with sort(list); only the
+//  sorting is timed
+template <typename Sort>
+double benchSortRounds(const LinkedList<int> &source, long long rounds, Sort sort)
+{
+    double ns = 0;
+    LinkedList<int> list;
+    for (long long r = 0; r < rounds; r++)
+    {
+        list = source;
+        ns += benchTime([&]() { sort(list); });
+        bench_sink += list.getElementAt(0);
+    }
+    return ns;
+}
+
+void benchSortList(const string &suite, int size, bool presorted)
+{
+    if (!benchEnabled(suite))
+    {
+        return;
+    }
+    LinkedList<int> source;
+    uint32_t state = 12345;
+    for (int i = 0; i < size; i++)
+        { source.addElement(presorted ? i : (int)(benchRandom(state) % 1000000)); }
+    long long rounds = 1 + 2000000 / size;
+
+    double ns = benchSortRounds(source, rounds, [](LinkedList<int> &list) {
+        list.sort();
+    });
+    benchReport(suite, "LinkedList", "int", size, size * rounds, ns);
+
+    ns = benchSortRounds(source, rounds, [](LinkedList<int> &list) {
+        vector<int> values(list.begin(), list.end());
+        stable_sort(values.begin(), values.end());
+        LinkedList<int> rebuilt;
+        for (int value : values)
+            { rebuilt.addElement(value); }
+        list = std::move(rebuilt);
+    });
+    benchReport(suite, "copy_out", "int", size, size * rounds, ns);
+}
+
+void benchSort()
+{
+    const int sizes[] = { 1000, 100000, 1000000 };
+    for (int size : sizes)
+    {
+        if (!benchSizeEnabled(size))
+        {
+            continue;
+        }
+        benchSortList("sort_list_random", size, false);
+        benchSortList("sort_list_sorted", size, true);
+    }
+}
+
+#endif
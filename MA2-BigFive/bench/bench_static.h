@@ -0,0 +1,86 @@
+/*
+ *  Benchmarks: virtual Indexed<T> calls vs. compile-time dispatch
+ *
+ *  Suites starting with static_* sum every item of a container three ways:
+ *    static_sum_virtual      getElementAt loop through an Indexed<int>&
+ *    static_sum_direct       the same loop on the concrete type
+ *    static_sum_accumulate   accumulateElements from StaticIndexed.h
+ */
+
+#ifndef BENCH_STATIC_H
+#define BENCH_STATIC_H
+
+#include <string>
+
+#include "bench_base.h"
+
+using namespace std;
+
+// Kept out of line so the compiler cannot see the dynamic type.  Non-const,
+//  so the lists can move their cursors along with the loop.
+__attribute__((noinline))
+long long benchStaticVirtualSum(Indexed<int> &items)
+{
+    long long total = 0;
+    for (int i = 0; i < items.getSize(); i++)
+        { total += items.getElementAt(i); }
+    return total;
+}
+
+template <typename C>
+void benchStaticSum(const string &name, int size)
+{
+    C items;
+    for (int i = 0; i < size; i++)
+        { items.addElement(i); }
+    long long rounds = 1 + 10000000 / size;
+
+    if (benchEnabled("static_sum_virtual"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += benchStaticVirtualSum(items); }
+        });
+        benchReport("static_sum_virtual", name, "int", size, size * rounds, ns);
+    }
+
+    if (benchEnabled("static_sum_direct"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+            {
+                long long total = 0;
+                for (int i = 0; i < items.getSize(); i++)
+                    { total += items.getElementAt(i); }
+                bench_sink += total;
+            }
+        });
+        benchReport("static_sum_direct", name, "int", size, size * rounds, ns);
+    }
+
+    if (benchEnabled("static_sum_accumulate"))
+    {
+        double ns = benchTime([&]() {
+            for (long long r = 0; r < rounds; r++)
+                { bench_sink += accumulateElements(items, 0LL); }
+        });
+        benchReport("static_sum_accumulate", name, "int", size, size * rounds, ns);
+    }
+}
+
+void benchStatic()
+{
+    const int sizes[] = { 1000, 100000 };
+    for (int size : sizes)
+    {
+        if (!benchSizeEnabled(size))
+        {
+            continue;
+        }
+        benchStaticSum< Vector<int> >("Vector", size);
+        benchStaticSum< LinkedList<int> >("LinkedList", size);
+        benchStaticSum< UnrolledLinkedList<int> >("UnrolledLinkedList", size);
+    }
+}
+
+#endif
@@ -0,0 +1,75 @@
+/*
+ *  Benchmark driver for the container library
+ *
+ *  Built with optimization by 'make bench'.  Results are CSV, on stdout or
+ *  in the file given with --csv.  See bench/bench_base.h for options.
+ */
+
+#include <iostream>
+
+#include "LinkedList.h"
+#include "ListNode.h"
+#include "NodePool.h"
+#include "PooledLinkedList.h"
+#include "Array.h"
+#include "Vector.h"
+#include "SmallArray.h"
+#include "ColumnArray.h"
+#include "MappedArray.h"
+#include "Serialize.h"
+#include "UnrolledLinkedList.h"
+#include "IndexLinkedList.h"
+#include "IntrusiveList.h"
+#include "SkipList.h"
+#include "DoublyLinkedList.h"
+#include "StaticIndexed.h"
+#include "ConcurrentLinkedList.h"
+#include "ConcurrentQueue.h"
+#include "ThreadPool.h"
+#include "ParallelAlgorithms.h"
+#include "SimdKernels.h"
+
+#include "bench/bench_base.h"
+#include "bench/bench_core.h"
+#include "bench/bench_pool.h"
+#include "bench/bench_array.h"
+#include "bench/bench_skiplist.h"
+#include "bench/bench_doubly.h"
+#include "bench/bench_static.h"
+#include "bench/bench_concurrent.h"
+#include "bench/bench_parallel.h"
+#include "bench/bench_simd.h"
+#include "bench/bench_sort.h"
+#include "bench/bench_column.h"
+#include "bench/bench_mapped.h"
+#include "bench/bench_serialize.h"
+#include "bench/bench_indexlist.h"
+#include "bench/bench_intrusive.h"
+
+// Main runs every benchmark suite in turn
+//  Suites are kept in the bench/ directory
+//  -- See the #include "bench/*" above
+int main(int argc, char *argv[])
+{
+    if (!benchConfigure(argc, argv))
+    {
+        return 1;
+    }
+    benchHeader();
+    benchCore();
+    benchPool();
+    benchArray();
+    benchSkipList();
+    benchDoubly();
+    benchStatic();
+    benchConcurrent();
+    benchParallel();
+    benchSimd();
+    benchSort();
+    benchColumn();
+    benchMapped();
+    benchSerialize();
+    benchIndexList();
+    benchIntrusive();
+    return 0;
+}
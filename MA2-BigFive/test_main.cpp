@@ -8,11 +8,52 @@
 
 #include "LinkedList.h"
 #include "ListNode.h"
+#include "NodePool.h"
+#include "PooledLinkedList.h"
+#include "Array.h"
+#include "Vector.h"
+#include "SmallArray.h"
+#include "ColumnArray.h"
+#include "MappedArray.h"
+#include "Serialize.h"
+#include "UnrolledLinkedList.h"
+#include "IndexLinkedList.h"
+#include "IntrusiveList.h"
+#include "SkipList.h"
+#include "DoublyLinkedList.h"
+#include "StaticIndexed.h"
+#include "Trace.h"
+#include "AllocationStats.h"
+#include "ConcurrentLinkedList.h"
+#include "ConcurrentQueue.h"
+#include "ThreadPool.h"
+#include "ParallelAlgorithms.h"
+#include "SimdKernels.h"
 
 #include "tests/test_starter.h"
 #include "tests/test_base.h"
 #include "tests/test_btests.h"
 #include "tests/test_atests.h"
+#include "tests/test_pool.h"
+#include "tests/test_array.h"
+#include "tests/test_smallarray.h"
+#include "tests/test_column.h"
+#include "tests/test_mapped.h"
+#include "tests/test_serialize.h"
+#include "tests/test_iterators.h"
+#include "tests/test_unrolled.h"
+#include "tests/test_indexlist.h"
+#include "tests/test_intrusive.h"
+#include "tests/test_skiplist.h"
+#include "tests/test_doubly.h"
+#include "tests/test_linkedlist.h"
+#include "tests/test_emplace.h"
+#include "tests/test_static.h"
+#include "tests/test_trace.h"
+#include "tests/test_stats.h"
+#include "tests/test_concurrent.h"
+#include "tests/test_parallel.h"
+#include "tests/test_simd.h"
 
 #include <sstream>      // stringstream stream buffer
 
@@ -0,0 +1,219 @@
+/*
+ *  Test suite for Array and Vector
+ *
+ *  All tests in this file should start with Array* or Vector*
+ */
+
+#ifndef ARRAY_TESTS_H
+#define ARRAY_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+// Copies the contents of any Indexed container out for comparisons
+template <typename T>
+vector<T> toVector(const Indexed<T> &items)
+{
+    vector<T> result;
+    for (int i = 0; i < items.getSize(); i++)
+        { result.push_back(items.getElementAt(i)); }
+    return result;
+}
+
+//****************** Start of Array tests *****************************//
+TEST(ArrayBasics, AddAndRemove)
+{
+    Array<int> numbers(5);
+    vector<int> vals = {2, 5, 7, 3};
+    for (auto val : vals)
+        { numbers.addElement(val); }
+    numbers.addElementAt(10, 1);
+    numbers.removeElementAt(0);
+    ASSERT_THAT(toVector(numbers), ElementsAre(10, 5, 7, 3));
+}
+
+TEST(ArrayBasics, ThrowsWhenFull)
+{
+    Array<int> numbers(2);
+    numbers.addElement(1);
+    numbers.addElement(2);
+    ASSERT_THROW(numbers.addElement(3), length_error);
+}
+
+TEST(ArrayBasics, CopyAndMove)
+{
+    Array<int> source{1, 2, 3};
+    Array<int> copy{ source };
+    copy.addElement(4);
+    Array<int> assigned(1);
+    assigned = source;
+    Array<int> moved{ std::move(source) };
+    ASSERT_THAT(toVector(copy), ElementsAre(1, 2, 3, 4));
+    ASSERT_THAT(toVector(assigned), ElementsAre(1, 2, 3));
+    ASSERT_THAT(toVector(moved), ElementsAre(1, 2, 3));
+    ASSERT_EQ(0, source.getSize());
+}
+
+// Element type without a default constructor that counts live instances
+struct Counted
+{
+    static int live;
+    int value;
+    explicit Counted(int v) : value(v) { live++; }
+    Counted(const Counted &other) : value(other.value) { live++; }
+    Counted &operator=(const Counted &other) { value = other.value; return *this; }
+    ~Counted() { live--; }
+};
+int Counted::live = 0;
+
+TEST(ArrayStorage, ConstructsOnlyLiveItems)
+{
+    {
+        Array<Counted> items(1000);
+        ASSERT_EQ(0, Counted::live);        // Nothing built up front
+        items.addElement(Counted{1});
+        items.addElement(Counted{2});
+        items.addElementAt(Counted{3}, 0);
+        ASSERT_EQ(3, Counted::live);
+        items.removeElementAt(1);
+        ASSERT_EQ(2, Counted::live);
+        Array<Counted> copy{ items };
+        ASSERT_EQ(4, Counted::live);
+        copy = items;
+        ASSERT_EQ(4, Counted::live);
+        ASSERT_EQ(3, copy.getElementAt(0).value);
+        ASSERT_EQ(2, copy.getElementAt(1).value);
+    }
+    ASSERT_EQ(0, Counted::live);            // Everything destroyed
+}
+
+TEST(ArrayStorage, SetElementAtAppendsButLeavesNoHoles)
+{
+    Array<string> words(4);
+    words.setElementAt("zero", 0);
+    words.setElementAt("one", 1);
+    words.setElementAt("ONE", 1);
+    ASSERT_THAT(toVector(words), ElementsAre("zero", "ONE"));
+    ASSERT_THROW(words.setElementAt("three", 3), out_of_range);
+}
+
+TEST(ArrayStorage, SetSizeDestroysAndDefaultConstructs)
+{
+    Array<string> words{ "a", "b", "c" };
+    words.setSize(1);
+    ASSERT_THAT(toVector(words), ElementsAre("a"));
+    words.setSize(3);
+    ASSERT_THAT(toVector(words), ElementsAre("a", "", ""));
+
+    Array<Counted> counted(2);
+    ASSERT_THROW(counted.setSize(2), invalid_argument);
+}
+
+TEST(ArrayStorage, TrivialItemsShiftAsBytes)
+{
+    struct Point { int x; double y; };
+    Array<Point> points(8);
+    for (int i = 0; i < 5; i++)
+        { points.addElement(Point{ i, i * 0.5 }); }
+    points.addElementAt(Point{ 9, 9.5 }, 2);
+    points.removeElementAt(0);
+    points.removeElementAt(4);
+    Array<Point> copy{ points };
+    vector<int> xs;
+    for (int i = 0; i < copy.getSize(); i++)
+        { xs.push_back(copy.getElementAt(i).x); }
+    ASSERT_THAT(xs, ElementsAre(1, 9, 2, 3));
+    ASSERT_EQ(9.5, copy.getElementAt(1).y);
+}
+
+TEST(ArrayStorage, GenericItemsShiftByMove)
+{
+    Array<string> words{ "b", "d" };
+    Vector<string> grown{ "b", "d" };
+    grown.addElementAt("a", 0);
+    grown.addElementAt("c", 2);
+    grown.removeElementAt(3);
+    ASSERT_THAT(toVector(grown), ElementsAre("a", "b", "c"));
+    words.removeElementAt(0);
+    ASSERT_THAT(toVector(words), ElementsAre("d"));
+}
+//****************** End of Array tests *******************************//
+
+
+//****************** Start of Vector tests ****************************//
+TEST(VectorGrowth, GrowsGeometrically)
+{
+    Vector<int> numbers;
+    ASSERT_EQ(0, numbers.capacity());
+    int reallocations = 0;
+    int last_capacity = numbers.capacity();
+    for (int i = 0; i < 1000; i++)
+    {
+        numbers.addElement(i);
+        if (numbers.capacity() != last_capacity)
+        {
+            reallocations++;
+            last_capacity = numbers.capacity();
+        }
+    }
+    ASSERT_EQ(1000, numbers.getSize());
+    ASSERT_EQ(999, numbers.getElementAt(999));
+    ASSERT_LE(reallocations, 10);           // 4, 8, ... 1024
+}
+
+TEST(VectorGrowth, InsertsAnywhere)
+{
+    Vector<int> numbers{1, 2, 3};
+    numbers.addElementAt(0, 0);
+    numbers.addElementAt(9, 2);
+    ASSERT_THAT(toVector(numbers), ElementsAre(0, 1, 9, 2, 3));
+    ASSERT_THROW(numbers.addElementAt(4, 7), out_of_range);
+}
+
+// The inserted value may live in the buffer that growing frees
+TEST(VectorGrowth, InsertsItsOwnItemsWhileGrowing)
+{
+    string alpha(40, 'a');
+    string beta(40, 'b');
+    Vector<string> words{ alpha, beta };
+    words.shrink_to_fit();
+    words.addElement(std::move(words.getElementAt(0)));
+    ASSERT_EQ(3, words.getSize());
+    ASSERT_EQ(alpha, words.getElementAt(2));
+    words.shrink_to_fit();
+    words.addElementAt(words.getElementAt(1), 0);
+    ASSERT_EQ(beta, words.getElementAt(0));
+    ASSERT_EQ(beta, words.getElementAt(2));
+}
+
+TEST(VectorGrowth, ReserveAndShrink)
+{
+    Vector<string> words;
+    words.reserve(50);
+    ASSERT_EQ(50, words.capacity());
+    words.addElement("alpha");
+    words.addElement("beta");
+    words.reserve(10);                      // Never shrinks
+    ASSERT_EQ(50, words.capacity());
+    words.shrink_to_fit();
+    ASSERT_EQ(2, words.capacity());
+    ASSERT_THAT(toVector(words), ElementsAre("alpha", "beta"));
+}
+
+TEST(VectorGrowth, MovedFromIsReusable)
+{
+    Vector<int> source{1, 2};
+    Vector<int> target;
+    target = std::move(source);
+    source.addElement(7);
+    ASSERT_THAT(toVector(target), ElementsAre(1, 2));
+    ASSERT_THAT(toVector(source), ElementsAre(7));
+}
+//****************** End of Vector tests ******************************//
+
+#endif
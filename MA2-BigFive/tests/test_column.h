@@ -0,0 +1,127 @@
+/*
+ *  Test suite for ColumnArray
+ *
+ *  All tests in this file should start with Column*
+ */
+
+#ifndef COLUMN_TESTS_H
+#define COLUMN_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+struct ColumnParticle
+{
+    double x;
+    float mass;
+    int id;
+    string label;           // Not described, so not stored
+};
+
+typedef ColumnArray<ColumnParticle, COLUMN_FIELD(ColumnParticle, x),
+                    COLUMN_FIELD(ColumnParticle, mass),
+                    COLUMN_FIELD(ColumnParticle, id)> ColumnParticles;
+
+TEST(ColumnArray, RowsRoundTrip)
+{
+    ColumnParticles particles{ {1.5, 2.0f, 7, "a"}, {-3.0, 0.5f, 9, "b"} };
+    ASSERT_EQ(3, ColumnParticles::FIELD_COUNT);
+    ASSERT_EQ(2, particles.getSize());
+
+    ColumnParticle second = particles.getElementAt(1);
+    ASSERT_EQ(-3.0, second.x);
+    ASSERT_EQ(0.5f, second.mass);
+    ASSERT_EQ(9, second.id);
+    ASSERT_EQ("", second.label);
+
+    particles.setElementAt({4.0, 1.0f, 11, "c"}, 0);
+    ASSERT_EQ(11, particles.getField<2>(0));
+    particles.getField<2>(0) = 12;
+    ASSERT_EQ(12, particles.getElementAt(0).id);
+    ASSERT_THROW(particles.getElementAt(2), out_of_range);
+    ASSERT_THROW(particles.addElementAt({}, 3), out_of_range);
+}
+
+TEST(ColumnArray, ColumnsAreContiguousAndInStep)
+{
+    ColumnParticles particles;
+    for (int i = 0; i < 100; i++)
+        { particles.addElement({ i * 0.5, 1.0f, i, "" }); }
+    particles.addElementAt({ -1.0, 2.0f, -1, "" }, 50);
+    particles.removeElementAt(0);
+
+    ColumnSpan<int> ids = particles.column<2>();
+    ASSERT_EQ(100, ids.getSize());
+    ASSERT_EQ(-1, ids[49]);
+    ASSERT_EQ(&ids[0] + 99, &ids[99]);
+    ASSERT_EQ(4949, simdSum(ids.data(), ids.getSize()));
+
+    const ColumnParticles &view = particles;
+    ColumnSpan<const float> masses = view.column<1>();
+    ASSERT_EQ(101.0f, simdSum(masses.data(), masses.getSize()));
+    ASSERT_EQ(49, simdFind(masses.data(), masses.getSize(), 2.0f));
+    ASSERT_EQ(24.5, particles.getElementAt(48).x);
+
+    particles.clear();
+    ASSERT_TRUE(particles.isEmpty());
+    ASSERT_TRUE(particles.column<0>().isEmpty());
+}
+
+// Copying one of these throws once armed
+struct ColumnFragile
+{
+    static bool armed;
+    int value = 0;
+
+    ColumnFragile() {}
+    ColumnFragile(const ColumnFragile &other) : value(other.value)
+    {
+        if (armed) { throw runtime_error("copy failed"); }
+    }
+    ColumnFragile &operator=(const ColumnFragile &other)
+    {
+        if (armed) { throw runtime_error("copy failed"); }
+        value = other.value;
+        return *this;
+    }
+};
+
+bool ColumnFragile::armed = false;
+
+struct ColumnPair
+{
+    int id;
+    ColumnFragile extra;
+};
+
+TEST(ColumnArray, FailedInsertKeepsColumnsInStep)
+{
+    ColumnArray<ColumnPair, COLUMN_FIELD(ColumnPair, id), COLUMN_FIELD(ColumnPair, extra)> rows;
+    rows.addElement(ColumnPair());
+    ColumnPair row;
+    row.id = 5;
+    ColumnFragile::armed = true;
+    ASSERT_THROW(rows.addElementAt(row, 0), runtime_error);
+    ColumnFragile::armed = false;
+
+    ASSERT_EQ(1, rows.getSize());
+    ASSERT_EQ(1, rows.column<0>().getSize());
+    ASSERT_EQ(0, rows.column<0>()[0]);      // The id went in and back out
+    rows.addElement(row);
+    ASSERT_EQ(5, rows.getElementAt(1).id);
+}
+
+TEST(ColumnArray, WorksWithStaticAlgorithms)
+{
+    ColumnParticles particles{ {1.0, 1.0f, 1, ""}, {2.0, 1.0f, 2, ""} };
+    int total = 0;
+    forEachElement(particles, [&total](const ColumnParticle &particle) { total += particle.id; });
+    ASSERT_EQ(3, total);
+}
+
+#endif
@@ -0,0 +1,281 @@
+/*
+ *  Test suite for the lock-free queue, its hazard pointers and the
+ *   fine-grained locking ConcurrentLinkedList
+ *
+ *  All tests in this file should start with Concurrent*
+ */
+
+#ifndef CONCURRENT_TESTS_H
+#define CONCURRENT_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+TEST(ConcurrentQueue, FifoOnOneThread)
+{
+    ConcurrentQueue<string> queue;
+    int value_count = 0;
+    string value;
+    ASSERT_TRUE(queue.isEmpty());
+    ASSERT_FALSE(queue.tryPop(value));
+
+    queue.push("first");
+    string second = "second";
+    queue.push(second);
+    queue.emplace(3, 'x');
+    ASSERT_EQ(3, queue.getApproximateSize());
+
+    while (queue.tryPop(value))
+    {
+        value_count++;
+        if (value_count == 1) { ASSERT_EQ("first", value); }
+        if (value_count == 3) { ASSERT_EQ("xxx", value); }
+    }
+    ASSERT_EQ(3, value_count);
+    ASSERT_TRUE(queue.isEmpty());
+}
+
+TEST(ConcurrentQueue, DrainIntoLinkedList)
+{
+    ConcurrentQueue<int> queue;
+    for (int i = 1; i <= 5; i++)
+        { queue.push(i); }
+    LinkedList<int> list{ 0 };
+    ASSERT_EQ(5, queue.drainInto(list));
+    ASSERT_THAT(toVector(list), ElementsAre(0, 1, 2, 3, 4, 5));
+    ASSERT_EQ(0, queue.drainInto(list));
+    ASSERT_EQ(0, queue.getApproximateSize());
+}
+
+TEST(ConcurrentQueue, ManyProducersAndConsumers)
+{
+    const int threads = 4;
+    const int per_thread = 5000;
+    ConcurrentQueue<int> queue;
+    vector<atomic<int> > seen(threads * per_thread);
+    for (auto &count : seen)
+        { count.store(0); }
+    atomic<int> popped(0);
+
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.push_back(thread([&, t]() {
+            for (int i = 0; i < per_thread; i++)
+                { queue.push(t * per_thread + i); }
+        }));
+        workers.push_back(thread([&]() {
+            int value = 0;
+            while (popped.load() < threads * per_thread)
+            {
+                if (queue.tryPop(value))
+                {
+                    seen[value]++;
+                    popped++;
+                }
+            }
+        }));
+    }
+    for (auto &worker : workers)
+        { worker.join(); }
+
+    for (auto &count : seen)
+        { ASSERT_EQ(1, count.load()); }     // Every value exactly once
+    ASSERT_EQ(0, queue.getApproximateSize());
+}
+
+TEST(ConcurrentQueue, PerProducerOrderIsKept)
+{
+    ConcurrentQueue<int> queue;
+    thread first([&]() { for (int i = 0; i < 2000; i++) { queue.push(i); } });
+    thread second([&]() { for (int i = 0; i < 2000; i++) { queue.push(100000 + i); } });
+    first.join();
+    second.join();
+
+    LinkedList<int> drained;
+    queue.drainInto(drained);
+    int last_first = -1;
+    int last_second = -1;
+    for (int value : drained)
+    {
+        int &last = value >= 100000 ? last_second : last_first;
+        ASSERT_LT(last, value);
+        last = value;
+    }
+    ASSERT_EQ(4000, drained.getSize());
+}
+
+TEST(ConcurrentLinkedList, IndexOperations)
+{
+    ConcurrentLinkedList<string> list;
+    ASSERT_TRUE(list.isEmpty());
+    list.addElement("b");
+    list.addElementAt("a", 0);
+    list.emplaceElement(2, 'd');
+    list.emplaceElementAt(2, "c");
+    ASSERT_EQ(4, list.getSize());
+    ASSERT_EQ("a", list.getElementAt(0));
+    ASSERT_EQ("c", list.getElementAt(2));
+    ASSERT_EQ("dd", list.getElementAt(3));
+
+    list.setElementAt("B", 1);
+    list.removeElementAt(3);
+    list.removeElementAt(0);
+    ASSERT_EQ(2, list.getSize());
+    ASSERT_EQ("B", list.getElementAt(0));
+    ASSERT_EQ("c", list.getElementAt(1));
+
+    ASSERT_THROW(list.getElementAt(2), out_of_range);
+    ASSERT_THROW(list.getElementAt(-1), out_of_range);
+    ASSERT_THROW(list.addElementAt("x", 3), out_of_range);
+    ASSERT_THROW(list.removeElementAt(2), out_of_range);
+    list.addElement("end");                 // Sentinel still usable
+    ASSERT_EQ("end", list.getElementAt(2));
+}
+
+TEST(ConcurrentLinkedList, CursorWalksAndEdits)
+{
+    ConcurrentLinkedList<int> list;
+    for (int i = 0; i < 6; i++)
+        { list.addElement(i); }
+    {
+        ConcurrentLinkedList<int>::Cursor cursor(list);
+        ASSERT_EQ(-1, cursor.getIndex());
+        ASSERT_THROW(cursor.getValue(), out_of_range);
+        while (cursor.next())
+        {
+            // Drop every odd value and double the even ones
+            cursor.getValue() *= 2;
+            cursor.removeNext();
+        }
+        ASSERT_EQ(2, cursor.getIndex());
+        ASSERT_FALSE(cursor.removeNext());
+        cursor.emplaceAfter(100);
+        cursor.reset();
+        ASSERT_TRUE(cursor.advance(4));
+        ASSERT_EQ(100, cursor.getValue());
+        ASSERT_FALSE(cursor.next());
+    }
+    ASSERT_EQ(4, list.getSize());
+    ASSERT_EQ(0, list.getElementAt(0));
+    ASSERT_EQ(4, list.getElementAt(1));
+    ASSERT_EQ(8, list.getElementAt(2));
+}
+
+// Throws from its constructor for negative values, and when assigned 13
+struct ConcurrentFussy
+{
+    int value;
+
+    ConcurrentFussy(int fussy_value = 0) : value(fussy_value)
+    {
+        if (fussy_value < 0)
+            { throw invalid_argument("negative"); }
+    }
+
+    ConcurrentFussy(const ConcurrentFussy &other) = default;
+
+    ConcurrentFussy &operator=(const ConcurrentFussy &other)
+    {
+        if (other.value == 13)
+            { throw runtime_error("unlucky"); }
+        value = other.value;
+        return *this;
+    }
+};
+
+TEST(ConcurrentLinkedList, AppendThatThrowsLeavesListUsable)
+{
+    ConcurrentLinkedList<ConcurrentFussy> list;
+    list.addElement(ConcurrentFussy(1));
+    ASSERT_THROW(list.emplaceElement(-1), invalid_argument);
+    ASSERT_THROW(list.emplaceElement(13), runtime_error);
+    ASSERT_EQ(1, list.getSize());
+    list.emplaceElement(3);                 // Would wait forever on a held lock
+    ASSERT_EQ(2, list.getSize());
+    ASSERT_EQ(3, list.getElementAt(1).value);
+}
+
+TEST(ConcurrentLinkedList, ParallelAppendsAndReaders)
+{
+    const int threads = 4;
+    const int per_thread = 2000;
+    ConcurrentLinkedList<int> list;
+    atomic<bool> done(false);
+
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.push_back(thread([&, t]() {
+            for (int i = 0; i < per_thread; i++)
+                { list.addElement(t * per_thread + i); }
+        }));
+    }
+    // Readers walk while the list grows; they must only see whole values
+    thread reader([&]() {
+        while (!done.load())
+        {
+            ConcurrentLinkedList<int>::Cursor cursor(list);
+            while (cursor.next())
+                { ASSERT_LT(cursor.getValue(), threads * per_thread); }
+        }
+    });
+    for (auto &worker : workers)
+        { worker.join(); }
+    done.store(true);
+    reader.join();
+
+    ASSERT_EQ(threads * per_thread, list.getSize());
+    vector<int> seen(threads * per_thread, 0);
+    ConcurrentLinkedList<int>::Cursor cursor(list);
+    while (cursor.next())
+        { seen[cursor.getValue()]++; }
+    for (int count : seen)
+        { ASSERT_EQ(1, count); }
+}
+
+TEST(ConcurrentLinkedList, DisjointRegionsEditedInParallel)
+{
+    const int threads = 4;
+    const int region = 500;
+    ConcurrentLinkedList<int> list;
+    for (int i = 0; i < threads * region; i++)
+        { list.addElement(i); }
+
+    // Thread t removes every other value in its own region, walking there
+    //  with its own cursor, while the others do the same further along
+    vector<thread> workers;
+    for (int t = 0; t < threads; t++)
+    {
+        workers.push_back(thread([&, t]() {
+            ConcurrentLinkedList<int>::Cursor cursor(list);
+            while (cursor.next() && cursor.getValue() < t * region)
+                { }
+            while (cursor.getValue() < (t + 1) * region - 1)
+            {
+                cursor.removeNext();
+                if (!cursor.next())
+                    { break; }
+            }
+        }));
+    }
+    for (auto &worker : workers)
+        { worker.join(); }
+
+    ASSERT_EQ(threads * region / 2, list.getSize());
+    ConcurrentLinkedList<int>::Cursor cursor(list);
+    int expected = 0;
+    while (cursor.next())
+    {
+        ASSERT_EQ(expected, cursor.getValue());
+        expected += 2;
+    }
+}
+
+#endif
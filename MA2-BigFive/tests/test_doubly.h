@@ -0,0 +1,91 @@
+/*
+ *  Test suite for DoublyLinkedList
+ *
+ *  All tests in this file should start with Doubly*
+ */
+
+#ifndef DOUBLY_TESTS_H
+#define DOUBLY_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+TEST(DoublyLinkedList, BackwardAndAlternatingAccess)
+{
+    DoublyLinkedList<int> numbers;
+    for (int i = 0; i < 100; i++)
+        { numbers.addElement(i); }
+    for (int i = 99; i >= 0; i--)
+        { ASSERT_EQ(i, numbers.getElementAt(i)); }
+    for (int i = 0; i < 50; i++)
+    {
+        ASSERT_EQ(i, numbers.getElementAt(i));
+        ASSERT_EQ(99 - i, numbers.getElementAt(99 - i));
+    }
+}
+
+TEST(DoublyLinkedList, ConstAccessUsesFingers)
+{
+    DoublyLinkedList<int> numbers{1, 2, 3, 4, 5};
+    const DoublyLinkedList<int> &view = numbers;
+    ASSERT_EQ(3, view.getElementAt(2));
+    ASSERT_EQ(2, view.getElementAt(1));
+    ASSERT_THROW(view.getElementAt(5), out_of_range);
+}
+
+TEST(DoublyLinkedList, MatchesVectorUnderRandomEdits)
+{
+    DoublyLinkedList<string> list;
+    vector<string> model;
+    srand(42);
+    for (int step = 0; step < 5000; step++)
+    {
+        int size = (int)model.size();
+        int choice = rand() % 4;
+        if (size == 0 || choice < 2)
+        {
+            int index = rand() % (size + 1);
+            list.addElementAt(to_string(step), index);
+            model.insert(model.begin() + index, to_string(step));
+        }
+        else if (choice == 2)
+        {
+            int index = rand() % size;
+            list.removeElementAt(index);
+            model.erase(model.begin() + index);
+        }
+        else
+        {
+            int index = rand() % size;
+            ASSERT_EQ(model[index], list.getElementAt(index));
+        }
+    }
+    vector<string> result(list.begin(), list.end());
+    ASSERT_THAT(result, ElementsAreArray(model));
+}
+
+TEST(DoublyLinkedList, BigFive)
+{
+    DoublyLinkedList<int> source{1, 2, 3};
+    DoublyLinkedList<int> copy{ source };
+    ASSERT_NE(source.getFront(), copy.getFront());
+    ListNode<int> *front = source.getFront();
+    DoublyLinkedList<int> moved{ std::move(source) };
+    ASSERT_EQ(front, moved.getFront());
+    ASSERT_EQ(0, source.getSize());
+
+    DoublyLinkedList<int> assigned{9};
+    assigned = copy;
+    assigned.removeElementAt(2);
+    assigned.removeElementAt(0);
+    ASSERT_THAT(toVector(assigned), ElementsAre(2));
+    assigned = std::move(moved);
+    ASSERT_THAT(toVector(assigned), ElementsAre(1, 2, 3));
+}
+
+#endif
@@ -0,0 +1,155 @@
+/*
+ *  Test suite for the move-aware and emplace insertion APIs
+ *
+ *  All tests in this file should start with Emplace*
+ */
+
+#ifndef EMPLACE_TESTS_H
+#define EMPLACE_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+// Counts how often values get copied or moved
+struct Tracked
+{
+    static int copies;
+    static int moves;
+    int first;
+    int second;
+
+    Tracked() : first(0), second(0) {}
+    Tracked(int a, int b) : first(a), second(b) {}
+    Tracked(const Tracked &other) : first(other.first), second(other.second) { copies++; }
+    Tracked(Tracked &&other) : first(other.first), second(other.second) { moves++; }
+    Tracked &operator=(const Tracked &other)
+        { first = other.first; second = other.second; copies++; return *this; }
+    Tracked &operator=(Tracked &&other)
+        { first = other.first; second = other.second; moves++; return *this; }
+
+    static void reset() { copies = 0; moves = 0; }
+};
+int Tracked::copies = 0;
+int Tracked::moves = 0;
+
+// Appends three ways and checks how many copies/moves each one costs
+template <typename C>
+void expectInsertCosts(C &items, int emplace_moves)
+{
+    Tracked lvalue{1, 2};
+    Tracked::reset();
+    items.addElement(lvalue);
+    ASSERT_EQ(1, Tracked::copies);
+    ASSERT_EQ(0, Tracked::moves);
+
+    Tracked::reset();
+    items.addElement(Tracked{3, 4});
+    ASSERT_EQ(0, Tracked::copies);
+    ASSERT_EQ(1, Tracked::moves);
+
+    Tracked::reset();
+    items.emplaceElement(5, 6);
+    items.emplaceElementAt(0, 7, 8);
+    ASSERT_EQ(0, Tracked::copies);
+    ASSERT_EQ(emplace_moves, Tracked::moves);
+
+    ASSERT_EQ(4, items.getSize());
+    ASSERT_EQ(7, items.getElementAt(0).first);
+    ASSERT_EQ(2, items.getElementAt(1).second);
+    ASSERT_EQ(6, items.getElementAt(3).second);
+}
+
+TEST(EmplaceContainers, ConstructInPlace)
+{
+    // The front emplace on Array/Vector/Unrolled shifts the 3 existing
+    //  items, then moves a temporary into the hole; appends are in place
+    Array<Tracked> array(8);
+    expectInsertCosts(array, 4);
+    Vector<Tracked> vector;
+    vector.reserve(8);
+    expectInsertCosts(vector, 4);
+    UnrolledLinkedList<Tracked> unrolled;
+    expectInsertCosts(unrolled, 4);
+    DoublyLinkedList<Tracked> doubly;
+    expectInsertCosts(doubly, 0);
+    SkipList<Tracked> skip;
+    expectInsertCosts(skip, 0);
+}
+
+TEST(EmplaceContainers, NodeFactoryListsMoveOnce)
+{
+    // createNode is a virtual hook, so the value is built then moved in
+    LinkedList<Tracked> list;
+    expectInsertCosts(list, 2);
+    PooledLinkedList<Tracked> pooled;
+    expectInsertCosts(pooled, 2);
+}
+
+TEST(EmplaceContainers, SetElementAtMoves)
+{
+    Vector<string> words{ "a", "b" };
+    string word = "long enough to live on the heap, not inline";
+    const char *buffer = word.data();
+    words.setElementAt(std::move(word), 1);
+    ASSERT_EQ(buffer, words.getElementAt(1).data());
+
+    SkipList<Tracked> skip;
+    skip.emplaceElement(1, 1);
+    Tracked::reset();
+    skip.setElementAt(Tracked{2, 2}, 0);
+    ASSERT_EQ(0, Tracked::copies);
+    ASSERT_EQ(2, skip.getElementAt(0).first);
+}
+
+TEST(EmplaceContainers, InsertingOwnItemIsSafe)
+{
+    // The source item moves during the shift or the reallocation
+    Vector<string> words{ "first", "second" };
+    words.addElementAt(words.getElementAt(1), 0);
+    words.addElementAt(words.getElementAt(0), 1);
+    ASSERT_THAT(toVector(words), ElementsAre("second", "second", "first", "second"));
+
+    Array<string> fixed(4);
+    fixed.addElement("x");
+    fixed.addElement("y");
+    fixed.emplaceElementAt(0, fixed.getElementAt(1));
+    ASSERT_THAT(toVector(fixed), ElementsAre("y", "x", "y"));
+
+    UnrolledLinkedList<string> unrolled{ "p", "q" };
+    unrolled.addElementAt(unrolled.getElementAt(1), 0);
+    ASSERT_THAT(toVector(unrolled), ElementsAre("q", "p", "q"));
+}
+
+TEST(EmplaceContainers, FullArrayThroughBaseReference)
+{
+    // A Vector seen as an Array must still grow on emplace
+    Vector<string> words;
+    Array<string> &base = words;
+    for (int i = 0; i < 10; i++)
+        { base.emplaceElement(3, 'a'); }
+    ASSERT_EQ(10, words.getSize());
+    ASSERT_EQ("aaa", words.getElementAt(9));
+
+    Array<string> fixed(1);
+    fixed.emplaceElement(2, 'b');
+    ASSERT_THROW(fixed.emplaceElement(2, 'c'), length_error);
+    ASSERT_THROW(fixed.emplaceElementAt(5, 1, 'c'), length_error);
+    ASSERT_THAT(toVector(fixed), ElementsAre("bb"));
+}
+
+TEST(EmplaceContainers, InterfaceFallbackMoves)
+{
+    LinkedList<string> list;
+    Indexed<string> &items = list;
+    items.emplaceElement(2, 'z');
+    items.emplaceElementAt(0, "front");
+    ASSERT_THAT(toVector(list), ElementsAre("front", "zz"));
+    ASSERT_THROW(items.emplaceElementAt(5, "far"), out_of_range);
+    ASSERT_EQ(2, list.getSize());
+}
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ *  Test suite for IndexLinkedList
+ *
+ *  All tests in this file should start with IndexLinkedList*
+ */
+
+#ifndef INDEX_LIST_TESTS_H
+#define INDEX_LIST_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+TEST(IndexLinkedList, SlotIsItemPlusIndex)
+{
+    ASSERT_EQ(8u, sizeof(IndexListSlot<int>));
+    ASSERT_LT(sizeof(IndexListSlot<int>) * 3, sizeof(ListNode<int>) + sizeof(void *));
+}
+
+TEST(IndexLinkedList, AppendsAndGrows)
+{
+    IndexLinkedList<int> numbers;
+    for (int i = 0; i < 100; i++)
+        { numbers.addElement(i); }
+    ASSERT_EQ(100, numbers.getSize());
+    ASSERT_EQ(128, numbers.capacity());
+    for (int i = 0; i < 100; i++)
+        { ASSERT_EQ(i, numbers.getElementAt(i)); }
+    numbers.addElementAt(-1, 0);
+    numbers.addElementAt(-2, 50);
+    ASSERT_EQ(-1, numbers.getElementAt(0));
+    ASSERT_EQ(-2, numbers.getElementAt(50));
+    ASSERT_EQ(99, numbers.getElementAt(101));
+}
+
+TEST(IndexLinkedList, ReusesFreedSlots)
+{
+    IndexLinkedList<int> numbers{1, 2, 3, 4};
+    ASSERT_EQ(4, numbers.capacity());
+    numbers.removeElementAt(1);
+    numbers.removeElementAt(2);
+    numbers.addElement(5);
+    numbers.addElementAt(6, 0);
+    ASSERT_EQ(4, numbers.capacity());
+    ASSERT_THAT(toVector(numbers), ElementsAre(6, 1, 3, 5));
+    numbers.addElement(7);                   // Free list is empty now
+    ASSERT_EQ(8, numbers.capacity());
+    numbers.compact();
+    ASSERT_EQ(5, numbers.capacity());
+    ASSERT_THAT(toVector(numbers), ElementsAre(6, 1, 3, 5, 7));
+    ASSERT_EQ(&numbers.getElementAt(0) + 2, &numbers.getElementAt(1));
+}
+
+TEST(IndexLinkedList, MatchesVectorUnderRandomEdits)
+{
+    IndexLinkedList<string> list;
+    vector<string> model;
+    srand(224);
+    for (int step = 0; step < 5000; step++)
+    {
+        int size = (int)model.size();
+        if (size == 0 || rand() % 3 != 0)
+        {
+            int index = rand() % (size + 1);
+            string value = to_string(step);
+            list.addElementAt(value, index);
+            model.insert(model.begin() + index, value);
+        }
+        else
+        {
+            int index = rand() % size;
+            list.removeElementAt(index);
+            model.erase(model.begin() + index);
+        }
+        if (step == 2500)
+            { list.compact(); }
+    }
+    ASSERT_EQ((int)model.size(), list.getSize());
+    vector<string> result(list.begin(), list.end());
+    ASSERT_THAT(result, ElementsAreArray(model));
+    for (int i = 0; i < list.getSize(); i += 7)
+        { ASSERT_EQ(model[i], list.getElementAt(i)); }
+}
+
+TEST(IndexLinkedList, AddsItsOwnItemWhileGrowing)
+{
+    IndexLinkedList<string> words{"alpha", "beta", "gamma", "delta"};
+    ASSERT_EQ(4, words.capacity());
+    words.addElement(words.getElementAt(1));
+    words.emplaceElementAt(0, words.getElementAt(4));
+    ASSERT_THAT(toVector(words), ElementsAre("beta", "alpha", "beta", "gamma", "delta", "beta"));
+}
+
+// Moving throws once moves_left runs out.  The move may throw, so
+//  growing the list copies instead.
+struct IndexFussy
+{
+    static int moves_left;
+
+    int value;
+
+    IndexFussy(int fussy_value = 0) : value(fussy_value)
+    {
+    }
+
+    IndexFussy(const IndexFussy &other) = default;
+    IndexFussy &operator=(const IndexFussy &other) = default;
+
+    IndexFussy(IndexFussy &&other) : value(other.value)
+    {
+        if (moves_left-- == 0)
+            { throw runtime_error("out of moves"); }
+    }
+};
+
+int IndexFussy::moves_left = 1000;
+
+TEST(IndexLinkedList, ThrowingInsertKeepsItsSlot)
+{
+    IndexLinkedList<IndexFussy> items{ 1, 2, 3, 4 };
+    ASSERT_EQ(4, items.capacity());
+    IndexFussy::moves_left = 1;             // Into a temporary, then into the slot
+    ASSERT_THROW(items.addElement(IndexFussy(5)), runtime_error);
+    IndexFussy::moves_left = 1000;
+    ASSERT_EQ(4, items.getSize());
+    ASSERT_EQ(8, items.capacity());
+    for (int i = 5; i <= 8; i++)
+        { items.addElement(IndexFussy(i)); }
+    ASSERT_EQ(8, items.capacity());         // No slot went missing
+    ASSERT_EQ(8, items.getElementAt(7).value);
+}
+
+TEST(IndexLinkedList, BigFive)
+{
+    IndexLinkedList<string> source{"a", "b", "c", "d"};
+    source.removeElementAt(1);
+    IndexLinkedList<string> copy{ source };
+    copy.setElementAt("x", 1);
+    ASSERT_EQ("c", source.getElementAt(1));
+    ASSERT_THAT(toVector(copy), ElementsAre("a", "x", "d"));
+    copy.addElement("e");                    // Copied free list hands out b's slot
+    ASSERT_EQ(4, copy.capacity());
+
+    IndexLinkedList<string> moved{ std::move(source) };
+    ASSERT_EQ(0, source.getSize());
+    ASSERT_EQ(0, source.capacity());
+    ASSERT_THAT(toVector(moved), ElementsAre("a", "c", "d"));
+
+    IndexLinkedList<string> assigned;
+    assigned = copy;
+    ASSERT_THAT(toVector(assigned), ElementsAre("a", "x", "d", "e"));
+    assigned = std::move(moved);
+    ASSERT_THAT(toVector(assigned), ElementsAre("a", "c", "d"));
+    ASSERT_THROW(assigned.getElementAt(3), out_of_range);
+    ASSERT_THROW(assigned.removeElementAt(-1), out_of_range);
+    ASSERT_THROW(assigned.addElementAt("z", 4), out_of_range);
+}
+
+TEST(IndexLinkedList, CopiesEmptyLists)
+{
+    IndexLinkedList<int> empty;
+    IndexLinkedList<int> copy{ empty };
+    ASSERT_EQ(0, copy.getSize());
+    ASSERT_EQ(0, copy.capacity());
+    IndexLinkedList<string> words;
+    IndexLinkedList<string> word_copy{ words };
+    word_copy = words;
+    word_copy.addElement("a");
+    ASSERT_THAT(toVector(word_copy), ElementsAre("a"));
+    copy.addElement(1);
+    ASSERT_THAT(toVector(copy), ElementsAre(1));
+}
+
+#endif
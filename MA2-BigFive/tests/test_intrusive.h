@@ -0,0 +1,171 @@
+/*
+ *  Test suite for IntrusiveList
+ *
+ *  All tests in this file should start with IntrusiveList*
+ */
+
+#ifndef INTRUSIVE_TESTS_H
+#define INTRUSIVE_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+struct IntrusiveByAge;
+struct IntrusiveByIdle;
+
+// A record that lives in a vector and is linked into two lists at once
+struct IntrusiveSession : IntrusiveListHook<IntrusiveByAge>, IntrusiveListHook<IntrusiveByIdle>
+{
+    static int copies;
+
+    int id;
+
+    IntrusiveSession(int session_id = 0) : id(session_id)
+    {
+    }
+
+    IntrusiveSession(const IntrusiveSession &other)
+        : IntrusiveListHook<IntrusiveByAge>(other), IntrusiveListHook<IntrusiveByIdle>(other),
+          id(other.id)
+    {
+        copies++;
+    }
+};
+
+int IntrusiveSession::copies = 0;
+
+typedef IntrusiveList<IntrusiveSession, IntrusiveByAge> IntrusiveAgeList;
+typedef IntrusiveList<IntrusiveSession, IntrusiveByIdle> IntrusiveIdleList;
+
+template <typename List>
+vector<int> intrusiveIds(const List &list)
+{
+    vector<int> ids;
+    for (const IntrusiveSession &session : list)
+        { ids.push_back(session.id); }
+    return ids;
+}
+
+// Safe mode must not change the layout of items
+TEST(IntrusiveList, HookLayoutIsTheSameInEveryMode)
+{
+    ASSERT_EQ(3 * sizeof(void *), sizeof(IntrusiveListHook<>));
+}
+
+TEST(IntrusiveList, LinksItemsInPlace)
+{
+    vector<IntrusiveSession> sessions{ 0, 1, 2, 3 };
+    IntrusiveSession::copies = 0;
+    IntrusiveAgeList list;
+    list.addBack(sessions[1]);
+    list.addBack(sessions[2]);
+    list.addFront(sessions[0]);
+    list.addBefore(sessions[2], sessions[3]);
+    ASSERT_EQ(0, IntrusiveSession::copies);
+    ASSERT_EQ(4, list.getSize());
+    ASSERT_EQ(&sessions[0], &list.getFront());
+    ASSERT_EQ(&sessions[2], &list.getBack());
+    ASSERT_THAT(intrusiveIds(list), ElementsAre(0, 1, 3, 2));
+    auto at = list.iteratorTo(sessions[3]);
+    ASSERT_EQ(1, (--at)->id);
+    list.clear();
+}
+
+TEST(IntrusiveList, RemovesByReference)
+{
+    vector<IntrusiveSession> sessions{ 0, 1, 2, 3, 4 };
+    IntrusiveAgeList list;
+    for (IntrusiveSession &session : sessions)
+        { list.addBack(session); }
+    list.remove(sessions[2]);
+    ASSERT_FALSE(static_cast<IntrusiveListHook<IntrusiveByAge> &>(sessions[2]).isLinked());
+    ASSERT_EQ(0, list.removeFront().id);
+    ASSERT_EQ(4, list.removeBack().id);
+    ASSERT_THAT(intrusiveIds(list), ElementsAre(1, 3));
+    list.addBack(sessions[2]);              // Removed items can join again
+    ASSERT_THAT(intrusiveIds(list), ElementsAre(1, 3, 2));
+    list.clear();
+    ASSERT_TRUE(list.isEmpty());
+    ASSERT_THROW(list.removeFront(), out_of_range);
+    ASSERT_THROW(list.getBack(), out_of_range);
+}
+
+TEST(IntrusiveList, ItemsInTwoLists)
+{
+    vector<IntrusiveSession> sessions{ 0, 1, 2 };
+    IntrusiveAgeList by_age;
+    IntrusiveIdleList by_idle;
+    for (IntrusiveSession &session : sessions)
+    {
+        by_age.addBack(session);
+        by_idle.addFront(session);
+    }
+    by_idle.remove(sessions[1]);
+    by_idle.addFront(sessions[1]);           // Touched: least idle again
+    by_age.remove(sessions[0]);
+    ASSERT_THAT(intrusiveIds(by_age), ElementsAre(1, 2));
+    ASSERT_THAT(intrusiveIds(by_idle), ElementsAre(1, 2, 0));
+}
+
+TEST(IntrusiveList, MovesAndUnlinksOnDestruction)
+{
+    vector<IntrusiveSession> sessions{ 0, 1, 2 };
+    IntrusiveAgeList source;
+    for (IntrusiveSession &session : sessions)
+        { source.addBack(session); }
+    IntrusiveAgeList moved{ std::move(source) };
+    ASSERT_EQ(0, source.getSize());
+    ASSERT_THAT(intrusiveIds(moved), ElementsAre(0, 1, 2));
+    moved.remove(sessions[1]);
+
+    IntrusiveAgeList assigned;
+    assigned.addBack(sessions[1]);
+    assigned = std::move(moved);
+    ASSERT_THAT(intrusiveIds(assigned), ElementsAre(0, 2));
+    ASSERT_FALSE(static_cast<IntrusiveListHook<IntrusiveByAge> &>(sessions[1]).isLinked());
+    {
+        IntrusiveAgeList scoped;
+        scoped.addBack(sessions[1]);
+    }
+    ASSERT_FALSE(static_cast<IntrusiveListHook<IntrusiveByAge> &>(sessions[1]).isLinked());
+
+    IntrusiveSession copy{ sessions[0] };    // Copies start unlinked
+    ASSERT_FALSE(static_cast<IntrusiveListHook<IntrusiveByAge> &>(copy).isLinked());
+    assigned.clear();
+}
+
+#if INTRUSIVE_SAFE_MODE
+TEST(IntrusiveList, SafeModeCatchesMisuse)
+{
+    vector<IntrusiveSession> sessions{ 0, 1 };
+    IntrusiveAgeList list;
+    IntrusiveAgeList other;
+    list.addBack(sessions[0]);
+    ASSERT_THROW(list.addBack(sessions[0]), logic_error);
+    ASSERT_THROW(other.addBack(sessions[0]), logic_error);
+    ASSERT_THROW(other.remove(sessions[0]), logic_error);
+    ASSERT_THROW(list.remove(sessions[1]), logic_error);
+    ASSERT_THROW(other.addBefore(sessions[0], sessions[1]), logic_error);
+    ASSERT_EQ(1, list.getSize());
+    ASSERT_EQ(0, other.getSize());
+    list.clear();
+}
+#endif
+
+#ifndef NDEBUG
+TEST(IntrusiveList, DestroyingALinkedItemAsserts)
+{
+    ASSERT_DEATH({
+        IntrusiveAgeList doomed;
+        IntrusiveSession session;
+        doomed.addBack(session);
+    }, "still in an IntrusiveList");
+}
+#endif
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ *  Test suite for container iterators
+ *
+ *  All tests in this file should start with Iterator*
+ */
+
+#ifndef ITERATOR_TESTS_H
+#define ITERATOR_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace testing;
+
+TEST(IteratorLinkedList, RangeFor)
+{
+    LinkedList<int> numbers{};
+    vector<int> vals = {2, 5, 7, 3, 6};
+    for (auto val : vals)
+        { numbers.addElement(val); }
+    vector<int> result;
+    for (int value : numbers)
+        { result.push_back(value); }
+    ASSERT_THAT(result, ElementsAreArray(vals));
+}
+
+TEST(IteratorLinkedList, WritesThroughIterator)
+{
+    PooledLinkedList<int> numbers{1, 2, 3};
+    for (int &value : numbers)
+        { value *= 10; }
+    ASSERT_EQ(20, numbers.getElementAt(1));
+}
+
+TEST(IteratorLinkedList, ConstAndAlgorithms)
+{
+    LinkedList<int> numbers{};
+    for (int i = 1; i <= 5; i++)
+        { numbers.addElement(i); }
+    const LinkedList<int> &view = numbers;
+    ASSERT_EQ(15, accumulate(view.begin(), view.end(), 0));
+    LinkedList<int>::const_iterator found = find(numbers.cbegin(), numbers.cend(), 4);
+    ASSERT_EQ(4, *found);
+    LinkedList<int>::const_iterator converted = numbers.begin();
+    ASSERT_EQ(5, distance(converted, view.end()));
+    ASSERT_TRUE(LinkedList<int>{}.begin() == LinkedList<int>{}.end());
+}
+
+TEST(IteratorArray, RandomAccess)
+{
+    Vector<int> numbers{5, 1, 4, 2, 3};
+    sort(numbers.begin(), numbers.end());
+    ASSERT_THAT(toVector(numbers), ElementsAre(1, 2, 3, 4, 5));
+    ASSERT_EQ(5, numbers.end() - numbers.begin());
+    ASSERT_EQ(3, numbers.begin()[2]);
+
+    const Array<int> &view = numbers;
+    int total = 0;
+    for (int value : view)
+        { total += value; }
+    ASSERT_EQ(15, total);
+}
+
+#endif
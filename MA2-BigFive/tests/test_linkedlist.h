@@ -0,0 +1,156 @@
+/*
+ *  Test suite for LinkedList copy assignment, clear() and sort()
+ *
+ *  All tests in this file should start with LinkedList*
+ */
+
+#ifndef LINKED_LIST_TESTS_H
+#define LINKED_LIST_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <algorithm>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+TEST(LinkedListCopyAssign, ReusesNodesOfSameSizedList)
+{
+    LinkedList<int> source{1, 2, 3, 4};
+    LinkedList<int> target{9, 9, 9, 9};
+    ListNode<int> *front = target.getFront();
+    ListNode<int> *second = front->getNext();
+
+    target = source;
+    ASSERT_EQ(front, target.getFront());    // Same nodes, new values
+    ASSERT_EQ(second, target.getFront()->getNext());
+    ASSERT_THAT(toVector(target), ElementsAre(1, 2, 3, 4));
+    ASSERT_THAT(toVector(source), ElementsAre(1, 2, 3, 4));
+}
+
+TEST(LinkedListCopyAssign, ShrinksAndGrows)
+{
+    LinkedList<int> longer{1, 2, 3, 4, 5};
+    LinkedList<int> shorter{7, 8};
+    LinkedList<int> empty{};
+    LinkedList<int> target{};
+
+    target = longer;
+    target = shorter;
+    ASSERT_THAT(toVector(target), ElementsAre(7, 8));
+    target.addElement(9);                   // End pointer must follow the cut
+    ASSERT_THAT(toVector(target), ElementsAre(7, 8, 9));
+
+    target = longer;
+    ASSERT_THAT(toVector(target), ElementsAre(1, 2, 3, 4, 5));
+    target.removeElementAt(4);
+    target.addElement(6);
+    ASSERT_THAT(toVector(target), ElementsAre(1, 2, 3, 4, 6));
+
+    target = empty;
+    ASSERT_TRUE(target.isEmpty());
+    ASSERT_EQ(nullptr, target.getFront());
+    target = target;
+    target.addElement(1);
+    ASSERT_THAT(toVector(target), ElementsAre(1));
+}
+
+TEST(LinkedListClear, EmptiesAndStaysUsable)
+{
+    LinkedList<int> numbers{1, 2, 3};
+    numbers.getElementAt(2);                // Leaves a cursor on the last node
+    numbers.clear();
+    ASSERT_EQ(0, numbers.getSize());
+    ASSERT_EQ(nullptr, numbers.getFront());
+
+    numbers.addElement(4);
+    numbers.addElementAt(5, 1);
+    ASSERT_THAT(toVector(numbers), ElementsAre(4, 5));
+    numbers.clear();
+    numbers.clear();
+    ASSERT_TRUE(numbers.isEmpty());
+}
+
+TEST(LinkedListCopyAssign, PooledListOnlyAllocatesTheDifference)
+{
+    PooledLinkedList<int> source{1, 2, 3};
+    PooledLinkedList<int> target(4);
+    for (int i = 0; i < 6; i++)
+        { target.addElement(i); }
+
+    target = source;
+    ASSERT_EQ(3, target.getPool().getLiveNodes());
+    ASSERT_THAT(toVector(target), ElementsAre(1, 2, 3));
+
+    target.clear();
+    ASSERT_EQ(0, target.getPool().getLiveNodes());
+    ASSERT_EQ(2, target.getPool().getBlockCount());
+}
+
+TEST(LinkedListSort, SortsEveryLengthAndKeepsNodes)
+{
+    for (int size = 0; size < 40; size++)
+    {
+        LinkedList<int> numbers;
+        for (int i = 0; i < size; i++)
+            { numbers.addElement((i * 17) % 11); }
+        vector<ListNode<int> *> nodes;
+        for (ListNode<int> *node = numbers.getFront(); node != nullptr; node = node->getNext())
+            { nodes.push_back(node); }
+
+        vector<int> expected = toVector(numbers);
+        std::sort(expected.begin(), expected.end());
+        numbers.sort();
+        ASSERT_EQ(expected, toVector(numbers));
+
+        // Same nodes, only relinked
+        vector<ListNode<int> *> sorted;
+        for (ListNode<int> *node = numbers.getFront(); node != nullptr; node = node->getNext())
+            { sorted.push_back(node); }
+        std::sort(nodes.begin(), nodes.end());
+        std::sort(sorted.begin(), sorted.end());
+        ASSERT_EQ(nodes, sorted);
+    }
+}
+
+TEST(LinkedListSort, CustomComparatorIsStable)
+{
+    LinkedList<pair<int, string> > people{ {3, "a"}, {1, "b"}, {3, "c"}, {2, "d"}, {1, "e"}, {3, "f"} };
+    people.sort([](const pair<int, string> &left, const pair<int, string> &right)
+        { return left.first > right.first; });
+
+    string order;
+    for (const pair<int, string> &person : people)
+        { order += person.second; }
+    ASSERT_EQ("acfdbe", order);
+}
+
+TEST(LinkedListSort, EndAndCursorFollowTheNewOrder)
+{
+    LinkedList<int> numbers{5, 1, 4, 2, 3};
+    ASSERT_EQ(4, numbers.getElementAt(2));  // Leaves a cursor on the node holding 4
+    numbers.sort();
+    ASSERT_EQ(3, numbers.getElementAt(2));
+    ASSERT_EQ(5, numbers.getElementAt(4));
+    numbers.addElement(0);                  // Appends after the new last node
+    numbers.removeElementAt(5);
+    numbers.addElementAt(6, 5);
+    ASSERT_THAT(toVector(numbers), ElementsAre(1, 2, 3, 4, 5, 6));
+}
+
+TEST(LinkedListSort, PooledListAllocatesNothing)
+{
+    PooledLinkedList<int> numbers(8);
+    for (int i = 0; i < 100; i++)
+        { numbers.addElement(100 - i); }
+    int blocks = numbers.getPool().getBlockCount();
+    numbers.sort();
+    ASSERT_EQ(blocks, numbers.getPool().getBlockCount());
+    ASSERT_EQ(100, numbers.getPool().getLiveNodes());
+    ASSERT_EQ(1, numbers.getElementAt(0));
+    ASSERT_EQ(100, numbers.getElementAt(99));
+}
+
+#endif
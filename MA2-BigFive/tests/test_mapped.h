@@ -0,0 +1,146 @@
+/*
+ *  Test suite for MappedArray
+ *
+ *  All tests in this file should start with MappedArray*
+ */
+
+#ifndef MAPPED_ARRAY_TESTS_H
+#define MAPPED_ARRAY_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <utility>
+
+using namespace testing;
+
+// A fresh path in the test temp directory; any old file there is removed
+string mappedTestPath(const string &name)
+{
+    string path = TempDir() + "ma2_mapped_" + name + ".bin";
+    remove(path.c_str());
+    return path;
+}
+
+long mappedFileSize(const string &path)
+{
+    ifstream file(path, ios::binary | ios::ate);
+    return (long)file.tellg();
+}
+
+TEST(MappedArray, GrowsAndReopens)
+{
+    string path = mappedTestPath("reopen");
+    {
+        MappedArray<double> numbers(path);
+        ASSERT_TRUE(numbers.isEmpty());
+        for (int i = 0; i < 1000; i++)
+            { numbers.addElement(i * 0.5); }
+        numbers.addElementAt(-1.0, 0);
+        numbers.removeElementAt(1000);
+        ASSERT_EQ(1000, numbers.getSize());
+        ASSERT_GE(numbers.capacity(), 1000);
+    }
+    ASSERT_EQ(64 + 1000 * 8, mappedFileSize(path));     // Spare capacity trimmed
+
+    MappedArray<double> numbers(path);
+    ASSERT_EQ(1000, numbers.getSize());
+    ASSERT_EQ(1000, numbers.capacity());
+    ASSERT_EQ(-1.0, numbers[0]);
+    ASSERT_EQ(0.5 * 998, numbers.getElementAt(999));
+    numbers.addElement(7.0);                            // Grows the file again
+    ASSERT_EQ(7.0, numbers[1000]);
+    remove(path.c_str());
+}
+
+TEST(MappedArray, SyncMakesItemsVisibleToReaders)
+{
+    string path = mappedTestPath("sync");
+    MappedArray<int> writer(path);
+    for (int i = 0; i < 10; i++)
+        { writer.addElement(i * i); }
+    writer.sync();
+
+    MappedArray<int> reader(path, MAPPED_READ_ONLY);
+    ASSERT_EQ(10, reader.getSize());
+    ASSERT_EQ(81, reader[9]);
+
+    writer[9] = 5;                                      // Shared pages: seen at once
+    ASSERT_EQ(5, reader[9]);
+    remove(path.c_str());
+}
+
+TEST(MappedArray, ReadOnlyNeverWritesBack)
+{
+    string path = mappedTestPath("readonly");
+    {
+        MappedArray<int> numbers(path);
+        numbers = Vector<int>{ 1, 2, 3 };
+    }
+
+    MappedArray<int> first(path, MAPPED_READ_ONLY);
+    MappedArray<int> second(path, MAPPED_READ_ONLY);
+    ASSERT_TRUE(first.isReadOnly());
+    first[0] = 100;                                     // Private to first
+    first.removeElementAt(2);
+    ASSERT_THAT(toVector(first), ElementsAre(100, 2));
+    ASSERT_THAT(toVector(second), ElementsAre(1, 2, 3));
+
+    first.addElement(4);                                // Fits in the file
+    ASSERT_THROW(first.addElement(5), length_error);
+    ASSERT_THROW(first.reserve(10), logic_error);
+    ASSERT_THROW(first.sync(), logic_error);
+
+    MappedArray<int> reopened(path, MAPPED_READ_ONLY);
+    ASSERT_THAT(toVector(reopened), ElementsAre(1, 2, 3));
+    remove(path.c_str());
+}
+
+TEST(MappedArray, RejectsOtherFilesUntouched)
+{
+    string path = mappedTestPath("foreign");
+    ASSERT_THROW(MappedArray<int> missing(path, MAPPED_READ_ONLY), runtime_error);
+
+    {
+        ofstream file(path, ios::binary);
+        file << string(100, 'x');
+    }
+    ASSERT_THROW(MappedArray<int> text(path), runtime_error);
+    ASSERT_EQ(100, mappedFileSize(path));
+
+    {
+        MappedArray<int> numbers(path + ".ints");
+        numbers.addElement(1);
+    }
+    ASSERT_THROW(MappedArray<double> doubles(path + ".ints"), runtime_error);
+    remove(path.c_str());
+    remove((path + ".ints").c_str());
+}
+
+TEST(MappedArray, WorksAsIndexedAndMoves)
+{
+    string path = mappedTestPath("indexed");
+    MappedArray<int> numbers(path);
+    Indexed<int> &indexed = numbers;
+    for (int i = 0; i < 20; i++)
+        { indexed.addElementAt(i, 0); }
+    indexed.setElementAt(-1, 20);                       // Appends
+    ASSERT_EQ(21, indexed.getSize());
+    ASSERT_EQ(19, indexed.getElementAt(0));
+
+    MappedArray<int> moved(std::move(numbers));
+    ASSERT_TRUE(numbers.isEmpty());
+    ASSERT_EQ(path, moved.path());
+    ASSERT_EQ(-1, moved[20]);
+
+    Vector<int> heap;
+    static_cast<Array<int> &>(heap) = std::move(moved); // Items leave the file
+    ASSERT_EQ(21, heap.getSize());
+    ASSERT_EQ(0, heap[19]);
+    ASSERT_TRUE(moved.isEmpty());
+    remove(path.c_str());
+}
+
+#endif
@@ -0,0 +1,138 @@
+/*
+ *  Test suite for the thread pool and the parallel algorithms
+ *
+ *  All tests in this file should start with Parallel* or ThreadPool*
+ */
+
+#ifndef PARALLEL_TESTS_H
+#define PARALLEL_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+using namespace testing;
+
+TEST(ThreadPool, RunsEveryTask)
+{
+    atomic<int> ran(0);
+    {
+        ThreadPool pool(3);
+        ASSERT_EQ(3, pool.getWorkerCount());
+        ASSERT_EQ(4, pool.getConcurrency());
+        for (int i = 0; i < 1000; i++)
+            { pool.submit([&ran]() { ran++; }); }
+    }                                       // Destructor drains the queues
+    ASSERT_EQ(1000, ran.load());
+    ASSERT_THROW(ThreadPool(-1), invalid_argument);
+}
+
+TEST(ThreadPool, CallerRunsTasksOfEmptyPool)
+{
+    ThreadPool pool(0);
+    int ran = 0;
+    pool.submit([&ran]() { ran++; });
+    pool.submit([&ran]() { ran++; });
+    while (pool.runPendingTask())
+        { }
+    ASSERT_EQ(2, ran);
+}
+
+TEST(Parallel, ForEachTransformReduceOnArray)
+{
+    ThreadPool pool(3);
+    ParallelOptions options;
+    options.pool = &pool;
+    options.chunk_size = 100;
+
+    Array<int> numbers(10000);
+    numbers.setSize(10000);
+    parallelForEach(numbers, [](int &item) { item = 1; }, options);
+    ASSERT_EQ(10000, accumulateElements(numbers, 0));
+
+    Array<long long> squares(10000);
+    squares.setSize(10000);
+    int index = 0;
+    for (int &item : numbers)
+        { item = index++; }
+    parallelTransform(numbers, squares, [](int item) { return (long long)item * item; }, options);
+    ASSERT_EQ(9999LL * 9999, squares[9999]);
+
+    long long total = parallelReduce(numbers, 0LL,
+        [](long long sum, long long item) { return sum + item; }, options);
+    ASSERT_EQ(9999LL * 10000 / 2, total);
+
+    Array<int> too_short(10);
+    ASSERT_THROW(parallelTransform(numbers, too_short, [](int item) { return item; }, options),
+                 invalid_argument);
+}
+
+TEST(Parallel, PlainPointerRanges)
+{
+    ParallelOptions options;
+    vector<double> values(5000, 0.5);
+    parallelForEach(values.data(), values.data() + values.size(),
+                    [](double &item) { item *= 2; }, options);
+    double total = parallelReduce(values.data(), values.data() + values.size(), 1.0,
+                                  [](double sum, double item) { return sum + item; });
+    ASSERT_DOUBLE_EQ(5001.0, total);
+
+    // Empty ranges return init and never call the function
+    ASSERT_EQ(7.0, parallelReduce(values.data(), values.data(), 7.0,
+                                  [](double, double) -> double { throw logic_error("called"); }));
+}
+
+TEST(Parallel, DeterministicReduceMatchesAcrossPools)
+{
+    Vector<double> values;
+    for (int i = 0; i < 200000; i++)
+        { values.addElement(1.0 / (i + 1)); }
+    auto add = [](double sum, double item) { return sum + item; };
+
+    ParallelOptions options;
+    options.deterministic = true;
+    ThreadPool one(0);
+    ThreadPool four(4);
+    options.pool = &one;
+    double first = parallelReduce(values, 0.0, add, options);
+    options.pool = &four;
+    for (int run = 0; run < 5; run++)
+        { ASSERT_EQ(first, parallelReduce(values, 0.0, add, options)); }   // Bit-for-bit
+}
+
+TEST(Parallel, ExceptionsReachTheCaller)
+{
+    ThreadPool pool(2);
+    ParallelOptions options;
+    options.pool = &pool;
+    options.chunk_size = 10;
+    vector<int> values(1000, 0);
+    values[500] = -1;
+    ASSERT_THROW(parallelForEach(values.data(), values.data() + values.size(), [](int item) {
+        if (item < 0) { throw out_of_range("negative"); }
+    }, options), out_of_range);
+
+    // The pool is still usable afterwards
+    ASSERT_EQ(-1, parallelReduce(values.data(), values.data() + values.size(), 0,
+                                 [](int sum, int item) { return sum + item; }, options));
+}
+
+TEST(Parallel, NestedCallsDoNotDeadlock)
+{
+    ThreadPool pool(2);
+    ParallelOptions options;
+    options.pool = &pool;
+    options.chunk_size = 1;
+    vector<int> rows(8, 0);
+    parallelForEach(rows.data(), rows.data() + rows.size(), [&](int &row) {
+        vector<int> cells(100, 1);
+        row = parallelReduce(cells.data(), cells.data() + cells.size(), 0,
+                             [](int sum, int item) { return sum + item; }, options);
+    }, options);
+    for (int row : rows)
+        { ASSERT_EQ(100, row); }
+}
+
+#endif
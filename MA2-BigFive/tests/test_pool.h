@@ -0,0 +1,127 @@
+/*
+ *  Test suite for the pooled node allocator
+ *
+ *  All tests in this file should start with Pool*
+ */
+
+#ifndef POOL_TESTS_H
+#define POOL_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <vector>
+#include <string>
+
+using namespace testing;
+
+TEST(PoolNodePool, RecyclesFreedSlots)
+{
+    NodePool<int> pool(4);
+    ListNode<int> *first = pool.allocate(1);
+    pool.deallocate(first);
+    ListNode<int> *second = pool.allocate(2);
+    ASSERT_EQ(first, second);               // Same slot handed back out
+    ASSERT_EQ(2, second->getValue());
+    ASSERT_EQ(1, pool.getLiveNodes());
+    pool.deallocate(second);
+}
+
+TEST(PoolNodePool, GrowsByWholeBlocks)
+{
+    NodePool<int> pool(4);
+    vector<ListNode<int> *> nodes;
+    for (int i = 0; i < 9; i++)
+        { nodes.push_back(pool.allocate(i)); }
+    ASSERT_EQ(3, pool.getBlockCount());     // 4 + 4 + 1
+    ASSERT_EQ(nodes[0] + 1, nodes[1]);      // Contiguous within a block
+    for (auto node : nodes)
+        { pool.deallocate(node); }
+    ASSERT_EQ(0, pool.getLiveNodes());
+}
+
+TEST(PoolLinkedList, BehavesLikeLinkedList)
+{
+    PooledLinkedList<int> numbers(8);
+    vector<int> vals = {2, 5, 7, 3, 6};
+    for (auto val : vals)
+        { numbers.addElement(val); }
+    numbers.addElementAt(10, 2);
+    numbers.removeElementAt(0);
+    vector<int> result;
+    for (int i = 0; i < numbers.getSize(); i++)
+        { result.push_back(numbers.getElementAt(i)); }
+    ASSERT_THAT(result, ElementsAre(5, 10, 7, 3, 6));
+    ASSERT_EQ(5, numbers.getPool().getLiveNodes());
+}
+
+TEST(PoolLinkedList, ChurnDoesNotGrowPool)
+{
+    PooledLinkedList<int> queue(16);
+    for (int i = 0; i < 16; i++)
+        { queue.addElement(i); }
+    for (int i = 0; i < 1000; i++)
+    {
+        queue.removeElementAt(0);
+        queue.addElement(i);
+    }
+    ASSERT_EQ(16, queue.getSize());
+    ASSERT_EQ(1, queue.getPool().getBlockCount());
+}
+
+TEST(PoolLinkedList, CopyAndMove)
+{
+    PooledLinkedList<int> source{1, 2, 3};
+    PooledLinkedList<int> copy{ source };
+    ASSERT_NE(source.getFront(), copy.getFront());
+
+    ListNode<int> *front = source.getFront();
+    PooledLinkedList<int> moved{ std::move(source) };
+    ASSERT_EQ(front, moved.getFront());
+    ASSERT_EQ(0, source.getSize());
+
+    PooledLinkedList<int> assigned;
+    assigned = copy;
+    ASSERT_EQ(3, assigned.getSize());
+    assigned = std::move(moved);
+    ASSERT_EQ(front, assigned.getFront());
+    ASSERT_EQ(3, assigned.getPool().getLiveNodes());
+    ASSERT_EQ(0, moved.getPool().getLiveNodes());
+    ASSERT_EQ(3, assigned.getElementAt(2));
+}
+
+
+// Nodes only change hands between lists that allocate them the same way;
+//  otherwise the values are moved and each list keeps its own nodes
+TEST(PoolLinkedList, MovesToAndFromPlainLists)
+{
+    LinkedList<string> plain;
+    {
+        PooledLinkedList<string> pooled{"a", "b", "c"};
+        plain = std::move(pooled);
+        ASSERT_EQ(0, pooled.getSize());
+        ASSERT_EQ(0, pooled.getPool().getLiveNodes());
+    }
+    ASSERT_EQ("b", plain.getElementAt(1));
+
+    PooledLinkedList<string> source{"d", "e"};
+    LinkedList<string> constructed{ std::move(static_cast<LinkedList<string> &>(source)) };
+    ASSERT_EQ(0, source.getSize());
+    ASSERT_EQ("e", constructed.getElementAt(1));
+
+    PooledLinkedList<string> pooled;
+    LinkedList<string> &as_list = pooled;
+    as_list = std::move(plain);
+    ASSERT_EQ(0, plain.getSize());
+    ASSERT_EQ(3, pooled.getPool().getLiveNodes());
+    pooled.removeElementAt(0);
+    ASSERT_EQ("b", pooled.getElementAt(0));
+
+    PooledLinkedList<string> other{"f"};
+    ListNode<string> *front = other.getFront();
+    as_list = std::move(static_cast<LinkedList<string> &>(other));
+    ASSERT_EQ(front, pooled.getFront());
+    ASSERT_EQ(1, pooled.getPool().getLiveNodes());
+    ASSERT_EQ(0, other.getPool().getLiveNodes());
+}
+
+#endif
@@ -0,0 +1,154 @@
+/*
+ *  Test suite for saving and loading containers (Serialize.h)
+ *
+ *  All tests in this file should start with Serialize*
+ */
+
+#ifndef SERIALIZE_TESTS_H
+#define SERIALIZE_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+using namespace testing;
+
+struct SerializePoint
+{
+    int x;
+    double weight;
+};
+
+TEST(Serialize, ArrayRoundTrip)
+{
+    Array<SerializePoint> points(3);
+    points.addElement(SerializePoint{ 1, 0.5 });
+    points.addElement(SerializePoint{ -2, 8.25 });
+
+    stringstream stream;
+    saveArray(stream, points);
+    ASSERT_EQ(64u + 2 * sizeof(SerializePoint), stream.str().size());
+
+    Vector<SerializePoint> loaded = loadVector<SerializePoint>(stream);
+    ASSERT_EQ(2, loaded.getSize());
+    ASSERT_EQ(2, loaded.capacity());
+    ASSERT_EQ(-2, loaded[1].x);
+    ASSERT_EQ(8.25, loaded[1].weight);
+}
+
+TEST(Serialize, ListRoundTripAcrossChunks)
+{
+    // More items than one staging chunk holds, and not a multiple of it
+    int count = 3 * SerializeItems<int>::chunkItems() + 5;
+    LinkedList<int> numbers;
+    for (int i = 0; i < count; i++)
+        { numbers.addElement(i * 3); }
+
+    stringstream stream;
+    saveList(stream, numbers);
+    string saved = stream.str();
+
+    LinkedList<int> loaded = loadList<int>(stream);
+    ASSERT_EQ(count, loaded.getSize());
+    ASSERT_EQ(0, loaded.getElementAt(0));
+    ASSERT_EQ((count - 1) * 3, loaded.getElementAt(count - 1));
+
+    // Lists and arrays share the format
+    stringstream array_stream(saved);
+    Vector<int> as_array = loadVector<int>(array_stream);
+    ASSERT_EQ(count, as_array.getSize());
+    stringstream resaved;
+    saveArray(resaved, as_array);
+    ASSERT_EQ(saved, resaved.str());
+}
+
+TEST(Serialize, PooledListLoadsIntoOneBlock)
+{
+    stringstream stream;
+    saveArray(stream, Vector<int>{ 4, 5, 6, 7 });
+    PooledLinkedList<int> loaded = loadPooledList<int>(stream);
+    ASSERT_THAT(vector<int>(loaded.begin(), loaded.end()), ElementsAre(4, 5, 6, 7));
+    ASSERT_EQ(1, loaded.getPool().getBlockCount());
+    ASSERT_EQ(4, loaded.getPool().getBlockSize());
+
+    stringstream empty;
+    saveList(empty, LinkedList<int>());
+    ASSERT_TRUE(loadPooledList<int>(empty).isEmpty());
+}
+
+TEST(Serialize, SavedFileMapsInPlace)
+{
+    string path = TempDir() + "ma2_serialize_points.bin";
+    {
+        ofstream file(path, ios::binary);
+        saveList(file, LinkedList<double>{ 1.5, 2.5, 3.5 });
+    }
+    MappedArray<double> mapped(path, MAPPED_READ_ONLY);
+    ASSERT_THAT(toVector(mapped), ElementsAre(1.5, 2.5, 3.5));
+    remove(path.c_str());
+}
+
+TEST(Serialize, RejectsBadStreams)
+{
+    stringstream ints;
+    saveArray(ints, Vector<int>{ 1, 2, 3 });
+    string saved = ints.str();
+
+    stringstream as_doubles(saved);
+    ASSERT_THROW(loadVector<double>(as_doubles), runtime_error);
+
+    stringstream truncated(saved.substr(0, saved.size() - 1));
+    ASSERT_THROW(loadList<int>(truncated), runtime_error);
+
+    stringstream text("not an array file at all, but long enough for a header.........");
+    ASSERT_THROW(loadVector<int>(text), runtime_error);
+}
+
+// A header can claim far more items than the stream holds
+TEST(Serialize, DoesNotTrustTheHeaderCount)
+{
+    ArrayFileHeader header = arrayFileHeader<int>(2147483647);
+    stringstream claimed;
+    claimed.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    int items[] = { 1, 2, 3 };
+    claimed.write(reinterpret_cast<const char *>(items), sizeof(items));
+    string saved = claimed.str();
+
+    stringstream for_vector(saved);
+    ASSERT_THROW(loadVector<int>(for_vector), runtime_error);
+    stringstream for_pool(saved);
+    ASSERT_THROW(loadPooledList<int>(for_pool), runtime_error);
+}
+
+// Items only need to be trivially copyable, not default-constructible
+struct SerializeId
+{
+    int value;
+
+    explicit SerializeId(int id) : value(id)
+    {
+    }
+};
+
+TEST(Serialize, LoadsItemsWithoutDefaultConstructor)
+{
+    Vector<SerializeId> ids;
+    ids.addElement(SerializeId(4));
+    ids.addElement(SerializeId(5));
+    stringstream stream;
+    saveArray(stream, ids);
+    Vector<SerializeId> loaded = loadVector<SerializeId>(stream);
+    ASSERT_EQ(2, loaded.getSize());
+    ASSERT_EQ(5, loaded[1].value);
+
+    stream.clear();
+    stream.seekg(0);
+    LinkedList<SerializeId> list = loadList<SerializeId>(stream);
+    ASSERT_EQ(2, list.getSize());
+    ASSERT_EQ(5, list.getElementAt(1).value);
+}
+
+#endif
@@ -0,0 +1,143 @@
+/*
+ *  Test suite for the vectorized kernels
+ *
+ *  All tests in this file should start with Simd*
+ */
+
+#ifndef SIMD_TESTS_H
+#define SIMD_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <vector>
+
+using namespace testing;
+
+// Runs check() once at every level this machine supports, then restores
+//  the best one
+template <typename Check>
+void simdAtEveryLevel(Check check)
+{
+    SimdLevel best = simdSupportedLevel();
+    for (int level = SIMD_SCALAR; level <= best; level++)
+    {
+        ASSERT_EQ(level, simdSetLevel((SimdLevel)level));
+        check();
+    }
+    simdSetLevel(best);
+}
+
+// Every kernel against the scalar loops, on sizes around the vector widths
+//  so both the vector body and the leftover items are covered
+template <typename T>
+void simdCheckAgainstScalar()
+{
+    for (int size = 0; size < 70; size++)
+    {
+        vector<T> left(size), right(size);
+        for (int i = 0; i < size; i++)
+        {
+            left[i] = (T)((i * 37) % 23 - 11);
+            right[i] = (T)((i * 11) % 7 - 3);
+        }
+        const T *items = left.data();
+
+        simdAtEveryLevel([&]() {
+            SCOPED_TRACE(simdLevelName(simdLevel()));
+            for (T value : { (T)-11, (T)0, (T)5, (T)100 })
+            {
+                ASSERT_EQ(simdFindScalar(items, size, value), simdFind(items, size, value));
+                ASSERT_EQ(simdCountScalar(items, size, value), simdCount(items, size, value));
+            }
+            ASSERT_EQ(simdSumScalar(items, size), simdSum(items, size));
+            ASSERT_EQ(simdDotScalar(items, right.data(), size), simdDot(items, right.data(), size));
+            ASSERT_EQ(simdMinIndexScalar(items, size), simdMinIndex(items, size));
+            ASSERT_EQ(simdMaxIndexScalar(items, size), simdMaxIndex(items, size));
+
+            vector<T> filled(size + 1, (T)9);
+            simdFill(filled.data(), size, (T)4);
+            ASSERT_EQ(size, simdCount(filled.data(), size + 1, (T)4));
+            ASSERT_EQ((T)9, filled[size]);
+
+            vector<T> copied(size + 1, (T)9);
+            simdCopy(copied.data(), items, size);
+            ASSERT_EQ(left, vector<T>(copied.begin(), copied.begin() + size));
+            ASSERT_EQ((T)9, copied[size]);
+        });
+    }
+}
+
+TEST(Simd, IntKernelsMatchScalar)
+{
+    simdCheckAgainstScalar<int>();
+}
+
+TEST(Simd, FloatKernelsMatchScalar)
+{
+    simdCheckAgainstScalar<float>();
+}
+
+TEST(Simd, DoubleKernelsMatchScalar)
+{
+    simdCheckAgainstScalar<double>();
+}
+
+TEST(Simd, IntSumsAndProductsDoNotOverflow)
+{
+    vector<int> big(100, 2000000000);
+    vector<int> negative(100, -2000000000);
+    vector<int> small(100, -3);
+    simdAtEveryLevel([&]() {
+        ASSERT_EQ(200000000000LL, simdSum(big.data(), 100));
+        ASSERT_EQ(-200000000000LL, simdSum(negative.data(), 100));
+        ASSERT_EQ(-600000000000LL, simdDot(big.data(), small.data(), 100));
+        ASSERT_EQ(600000000000LL, simdDot(small.data(), negative.data(), 100));
+    });
+}
+
+TEST(Simd, ExtremesReportFirstIndex)
+{
+    vector<double> values(50, 1.5);
+    values[17] = -3;
+    values[40] = -3;
+    values[3] = 8;
+    values[49] = 8;
+    simdAtEveryLevel([&]() {
+        ASSERT_EQ(17, simdMinIndex(values.data(), 50));
+        ASSERT_EQ(3, simdMaxIndex(values.data(), 50));
+        ASSERT_EQ(-1, simdMinIndex(values.data(), 0));
+    });
+}
+
+TEST(Simd, ArrayOverloads)
+{
+    Array<float> numbers(1000);
+    numbers.setSize(1000);
+    simdFill(numbers, 0.25f);
+    ASSERT_EQ(1000, simdCount(numbers, 0.25f));
+    numbers[600] = 2.0f;
+    ASSERT_EQ(600, simdFind(numbers, 2.0f));
+    ASSERT_EQ(600, simdMaxIndex(numbers));
+    ASSERT_FLOAT_EQ(251.75f, simdSum(numbers));
+
+    Array<float> copy(1000);
+    copy.setSize(1000);
+    simdCopy(numbers, copy);
+    ASSERT_EQ(2.0f, copy[600]);
+    ASSERT_FLOAT_EQ(4.0f + 999 * 0.0625f, simdDot(numbers, copy));
+
+    Array<float> other(10);
+    ASSERT_THROW(simdCopy(numbers, other), invalid_argument);
+    ASSERT_THROW(simdDot(numbers, other), invalid_argument);
+}
+
+TEST(Simd, LevelIsCappedAtSupported)
+{
+    SimdLevel best = simdSupportedLevel();
+    ASSERT_EQ(best, simdLevel());
+    ASSERT_EQ(best, simdSetLevel(SIMD_AVX512));
+    ASSERT_EQ(SIMD_SCALAR, simdSetLevel(SIMD_SCALAR));
+    simdSetLevel(best);
+}
+
+#endif
@@ -0,0 +1,93 @@
+/*
+ *  Test suite for the indexable SkipList
+ *
+ *  All tests in this file should start with SkipList*
+ */
+
+#ifndef SKIPLIST_TESTS_H
+#define SKIPLIST_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <cstdlib>
+#include <vector>
+
+using namespace testing;
+
+TEST(SkipList, BasicIndexedBehavior)
+{
+    SkipList<int> numbers;
+    ASSERT_TRUE(numbers.isEmpty());
+    vector<int> vals = {2, 5, 7, 3, 6};
+    for (auto val : vals)
+        { numbers.addElement(val); }
+    numbers.addElementAt(10, 0);
+    numbers.addElementAt(11, 3);
+    numbers.setElementAt(12, 6);
+    numbers.removeElementAt(1);
+    ASSERT_THAT(toVector(numbers), ElementsAre(10, 5, 11, 7, 3, 12));
+    ASSERT_THROW(numbers.getElementAt(6), out_of_range);
+    ASSERT_THROW(numbers.addElementAt(1, 8), out_of_range);
+    ASSERT_THROW(numbers.removeElementAt(-1), out_of_range);
+}
+
+TEST(SkipList, MatchesVectorUnderRandomEdits)
+{
+    SkipList<int> list;
+    vector<int> model;
+    srand(7);
+    for (int step = 0; step < 20000; step++)
+    {
+        int size = (int)model.size();
+        int choice = rand() % 4;
+        if (size == 0 || choice < 2)
+        {
+            int index = rand() % (size + 1);
+            list.addElementAt(step, index);
+            model.insert(model.begin() + index, step);
+        }
+        else if (choice == 2)
+        {
+            int index = rand() % size;
+            list.removeElementAt(index);
+            model.erase(model.begin() + index);
+        }
+        else
+        {
+            int index = rand() % size;
+            ASSERT_EQ(model[index], list.getElementAt(index));
+        }
+    }
+    ASSERT_EQ((int)model.size(), list.getSize());
+    vector<int> result(list.begin(), list.end());
+    ASSERT_THAT(result, ElementsAreArray(model));
+}
+
+TEST(SkipList, BigFive)
+{
+    SkipList<int> source;
+    for (int i = 0; i < 100; i++)
+        { source.addElement(i); }
+    SkipList<int> copy{ source };
+    copy.removeElementAt(0);
+    ASSERT_EQ(0, source.getElementAt(0));
+    ASSERT_EQ(50, copy.getElementAt(49));
+    copy.addElementAt(-1, 50);              // Copy's towers still consistent
+    ASSERT_EQ(-1, copy.getElementAt(50));
+    ASSERT_EQ(51, copy.getElementAt(51));
+
+    SkipList<int> moved{ std::move(source) };
+    ASSERT_EQ(0, source.getSize());
+    ASSERT_EQ(99, moved.getElementAt(99));
+    source.addElement(5);                   // Moved-from list is reusable
+    ASSERT_EQ(5, source.getElementAt(0));
+
+    SkipList<int> assigned{1, 2};
+    assigned = copy;
+    ASSERT_EQ(100, assigned.getSize());
+    assigned = std::move(moved);
+    ASSERT_EQ(100, assigned.getSize());
+    ASSERT_EQ(42, assigned.getElementAt(42));
+}
+
+#endif
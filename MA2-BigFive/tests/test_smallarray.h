@@ -0,0 +1,129 @@
+/*
+ *  Test suite for SmallArray
+ *
+ *  All tests in this file should start with SmallArray*
+ */
+
+#ifndef SMALL_ARRAY_TESTS_H
+#define SMALL_ARRAY_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+TEST(SmallArray, StaysInlineUntilItSpills)
+{
+    SmallArray<int, 4> numbers;
+    ASSERT_TRUE(numbers.isInline());
+    ASSERT_EQ(4, numbers.capacity());
+    for (int i = 0; i < 4; i++)
+        { numbers.addElement(i); }
+    ASSERT_TRUE(numbers.isInline());
+    const char *object = reinterpret_cast<const char *>(&numbers);
+    const char *items = reinterpret_cast<const char *>(numbers.begin());
+    ASSERT_TRUE(items >= object && items < object + sizeof(numbers));   // Inside the object
+
+    numbers.addElementAt(9, 0);
+    ASSERT_FALSE(numbers.isInline());
+    ASSERT_EQ(8, numbers.capacity());
+    ASSERT_THAT(toVector(numbers), ElementsAre(9, 0, 1, 2, 3));
+
+    numbers.removeElementAt(0);
+    numbers.shrink_to_fit();
+    ASSERT_TRUE(numbers.isInline());
+    ASSERT_THAT(toVector(numbers), ElementsAre(0, 1, 2, 3));
+}
+
+TEST(SmallArray, ShrinkKeepsInlineItemsInline)
+{
+    SmallArray<int, 4> numbers{ 1, 2 };
+    numbers.shrink_to_fit();
+    ASSERT_TRUE(numbers.isInline());
+    ASSERT_EQ(4, numbers.capacity());
+    ASSERT_THAT(toVector(numbers), ElementsAre(1, 2));
+
+    SmallArray<int, 4> empty;
+    empty.shrink_to_fit();
+    ASSERT_TRUE(empty.isInline());
+    ASSERT_EQ(4, empty.capacity());
+}
+
+TEST(SmallArray, CopiesInlineAndSpilled)
+{
+    SmallArray<string, 2> inline_words{ "a", "b" };
+    SmallArray<string, 2> spilled_words{ "c", "d", "e" };
+    ASSERT_TRUE(inline_words.isInline());
+    ASSERT_FALSE(spilled_words.isInline());
+
+    SmallArray<string, 2> copy(inline_words);
+    ASSERT_TRUE(copy.isInline());
+    ASSERT_THAT(toVector(copy), ElementsAre("a", "b"));
+
+    copy = spilled_words;
+    ASSERT_FALSE(copy.isInline());
+    ASSERT_THAT(toVector(copy), ElementsAre("c", "d", "e"));
+    ASSERT_NE(copy.begin(), spilled_words.begin());
+
+    copy = inline_words;                    // Fits again, so goes back inline
+    ASSERT_TRUE(copy.isInline());
+    ASSERT_THAT(toVector(copy), ElementsAre("a", "b"));
+    ASSERT_THAT(toVector(spilled_words), ElementsAre("c", "d", "e"));
+}
+
+TEST(SmallArray, MovesInlineAndSpilled)
+{
+    SmallArray<string, 2> words{ "a", "b" };
+    SmallArray<string, 2> moved(std::move(words));
+    ASSERT_TRUE(moved.isInline());
+    ASSERT_THAT(toVector(moved), ElementsAre("a", "b"));
+    ASSERT_TRUE(words.isEmpty());
+    ASSERT_TRUE(words.isInline());
+    words.addElement("reused");
+
+    SmallArray<string, 2> spilled{ "c", "d", "e" };
+    const string *items = spilled.begin();
+    moved = std::move(spilled);             // Steals the heap buffer
+    ASSERT_EQ(items, moved.begin());
+    ASSERT_THAT(toVector(moved), ElementsAre("c", "d", "e"));
+    ASSERT_TRUE(spilled.isInline());
+    ASSERT_TRUE(spilled.isEmpty());
+
+    moved = std::move(words);               // Spilled target goes back inside
+    ASSERT_TRUE(moved.isInline());
+    ASSERT_THAT(toVector(moved), ElementsAre("reused"));
+}
+
+TEST(SmallArray, AssignsThroughArrayReferences)
+{
+    SmallArray<int, 4> numbers;
+    Array<int> &as_array = numbers;
+
+    Vector<int> few{ 1, 2, 3 };
+    as_array = few;
+    ASSERT_TRUE(numbers.isInline());
+    ASSERT_THAT(toVector(numbers), ElementsAre(1, 2, 3));
+
+    as_array = std::move(few);              // Moved into our own space
+    ASSERT_TRUE(numbers.isInline());
+    ASSERT_TRUE(few.isEmpty());
+
+    Vector<int> many{ 1, 2, 3, 4, 5, 6 };
+    const int *items = many.begin();
+    as_array = std::move(many);             // Too many: steals the buffer
+    ASSERT_EQ(items, numbers.begin());
+    ASSERT_EQ(6, numbers.getSize());
+
+    // An inline SmallArray moved into a plain Vector gets a heap copy
+    SmallArray<int, 4> small{ 7, 8 };
+    Vector<int> target;
+    static_cast<Array<int> &>(target) = std::move(small);
+    ASSERT_THAT(toVector(target), ElementsAre(7, 8));
+    ASSERT_TRUE(small.isEmpty());
+    ASSERT_TRUE(small.isInline());
+}
+
+#endif
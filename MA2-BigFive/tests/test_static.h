@@ -0,0 +1,58 @@
+/*
+ *  Test suite for the compile-time dispatched algorithms in StaticIndexed.h
+ *
+ *  All tests in this file should start with Static*
+ */
+
+#ifndef STATIC_TESTS_H
+#define STATIC_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+TEST(StaticIndexed, RecognizesIndexedContainers)
+{
+    ASSERT_TRUE(IsStaticIndexed< Array<int> >::value);
+    ASSERT_TRUE(IsStaticIndexed< Vector<string> >::value);
+    ASSERT_TRUE(IsStaticIndexed< LinkedList<int> >::value);
+    ASSERT_TRUE(IsStaticIndexed< SkipList<int> >::value);
+    ASSERT_TRUE(IsStaticIndexed< Indexed<int> >::value);   // The runtime adapter
+    ASSERT_FALSE(IsStaticIndexed< vector<int> >::value);
+    ASSERT_FALSE(IsStaticIndexed<int>::value);
+
+    ASSERT_TRUE(HasIndexedIterators< UnrolledLinkedList<int> >::value);
+    ASSERT_FALSE(HasIndexedIterators< Indexed<int> >::value);
+    ASSERT_TRUE((is_same<IndexedValue< Vector<string> >::type, string>::value));
+}
+
+TEST(StaticIndexed, AlgorithmsOnConcreteContainers)
+{
+    Vector<int> numbers{ 4, 8, 15, 16, 23, 42 };
+    ASSERT_EQ(108, accumulateElements(numbers, 0));
+    ASSERT_EQ(3, findElement(numbers, 16));
+    ASSERT_EQ(-1, findElement(numbers, 7));
+
+    DoublyLinkedList<string> words{ "a", "b", "c" };
+    ASSERT_EQ("abc", accumulateElements(words, string()));
+    ASSERT_EQ(2, findElement(words, "c"));
+
+    forEachElement(numbers, [](int &value) { value *= 2; });
+    ASSERT_THAT(toVector(numbers), ElementsAre(8, 16, 30, 32, 46, 84));
+}
+
+TEST(StaticIndexed, AlgorithmsThroughVirtualAdapter)
+{
+    SkipList<int> skip{ 1, 2, 3 };
+    Indexed<int> &items = skip;
+    ASSERT_EQ(6, accumulateElements(items, 0));
+    ASSERT_EQ(1, findElement(items, 2));
+    int visited = 0;
+    forEachElement(items, [&visited](int value) { visited += value; });
+    ASSERT_EQ(6, visited);
+}
+
+#endif
@@ -0,0 +1,147 @@
+/*
+ *  Test suite for the allocation counters (AllocationStats.h)
+ *
+ *  All tests in this file should start with AllocationStats*
+ *  The counts are only checked in builds with CONTAINER_STATS
+ *  (make test STATS=1); otherwise everything must read zero.
+ */
+
+#ifndef ALLOCATION_STATS_TESTS_H
+#define ALLOCATION_STATS_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <thread>
+#include <utility>
+#include <vector>
+
+using namespace testing;
+
+#ifdef CONTAINER_STATS
+
+TEST(AllocationStats, ListCountsNodesAndOverhead)
+{
+    const long long node = sizeof(ListNode<int>);
+    LinkedList<int> numbers{ 1, 2, 3 };
+    numbers.removeElementAt(1);
+    AllocationStats stats = numbers.getStats();
+    ASSERT_EQ(3, stats.allocations);
+    ASSERT_EQ(1, stats.frees);
+    ASSERT_EQ(2, stats.live_nodes);
+    ASSERT_EQ(3, stats.peak_nodes);
+    ASSERT_EQ(2 * node, stats.live_bytes);
+    ASSERT_EQ(2 * (node - (long long)sizeof(int)), stats.overhead_bytes);
+
+    LinkedList<int> copy(numbers);
+    ASSERT_EQ(1, copy.getStats().copies);
+    ASSERT_EQ(2, copy.getStats().allocations);
+
+    LinkedList<int> moved(std::move(copy));
+    ASSERT_EQ(1, moved.getStats().moves);
+    ASSERT_EQ(0, moved.getStats().allocations);
+    ASSERT_EQ(2, moved.getStats().live_nodes);  // The nodes came along
+    ASSERT_EQ(0, copy.getStats().live_nodes);
+
+    moved = numbers;
+    ASSERT_EQ(1, moved.getStats().copies);
+    ASSERT_EQ(0, moved.getStats().allocations); // Nodes were reused
+}
+
+TEST(AllocationStats, PooledListCountsNodes)
+{
+    PooledLinkedList<int> numbers{ 1, 2, 3 };
+    numbers.removeElementAt(0);
+    ASSERT_EQ(3, numbers.getStats().allocations);
+    ASSERT_EQ(1, numbers.getStats().frees);
+    ASSERT_EQ(2, numbers.getStats().live_nodes);
+
+    PooledLinkedList<int> copy(numbers);
+    ASSERT_EQ(1, copy.getStats().copies);
+    ASSERT_EQ(2, copy.getStats().live_nodes);
+}
+
+TEST(AllocationStats, ArraysCountBuffers)
+{
+    Vector<int> numbers;
+    for (int i = 0; i < 5; i++)
+        { numbers.addElement(i); }
+    AllocationStats stats = numbers.getStats();
+    ASSERT_EQ(2, stats.allocations);            // Capacity 4, then 8
+    ASSERT_EQ(1, stats.frees);
+    ASSERT_EQ(0, stats.live_nodes);
+    ASSERT_EQ(32, stats.live_bytes);
+    ASSERT_EQ(48, stats.peak_bytes);            // Both buffers while moving
+    ASSERT_EQ(0, stats.overhead_bytes);
+
+    Vector<int> copy(numbers);
+    ASSERT_EQ(1, copy.getStats().copies);
+    Vector<int> moved(std::move(copy));
+    ASSERT_EQ(1, moved.getStats().moves);
+    ASSERT_EQ(24, moved.getStats().live_bytes);
+    ASSERT_EQ(0, copy.getStats().live_bytes);
+
+    SmallArray<int, 4> small{ 1, 2, 3 };
+    ASSERT_EQ(0, small.getStats().allocations); // Inline
+    small.addElement(4);
+    small.addElement(5);
+    ASSERT_EQ(1, small.getStats().allocations);
+}
+
+TEST(AllocationStats, GlobalCountersBalance)
+{
+    AllocationStats::resetGlobal();
+    {
+        LinkedList<int> list{ 1, 2, 3 };
+        Vector<int> array{ 1, 2 };
+        LinkedList<int> other(std::move(list));
+        AllocationStats global = AllocationStats::global();
+        ASSERT_EQ(4, global.allocations);
+        ASSERT_EQ(3, global.live_nodes);
+        ASSERT_EQ(1, global.moves);
+    }
+    AllocationStats global = AllocationStats::global();
+    ASSERT_EQ(global.allocations, global.frees);
+    ASSERT_EQ(0, global.live_nodes);
+    ASSERT_EQ(0, global.live_bytes);
+    ASSERT_EQ(3, global.peak_nodes);
+}
+
+TEST(AllocationStats, GlobalCountsAcrossThreads)
+{
+    AllocationStats::resetGlobal();
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.emplace_back([]() {
+            LinkedList<int> numbers;
+            for (int i = 0; i < 100; i++)
+                { numbers.addElement(i); }
+        });
+    }
+    for (thread &worker : threads)
+        { worker.join(); }
+
+    AllocationStats global = AllocationStats::global();   // Exited threads still count
+    ASSERT_EQ(400, global.allocations);
+    ASSERT_EQ(400, global.frees);
+    ASSERT_EQ(0, global.live_nodes);
+    ASSERT_EQ(400, global.peak_nodes);                    // Sum of per-thread peaks
+}
+
+#else
+
+TEST(AllocationStats, CompiledOutReadsZero)
+{
+    AllocationStats::resetGlobal();
+    LinkedList<int> list{ 1, 2, 3 };
+    Vector<int> array{ 1, 2 };
+    LinkedList<int> copy(list);
+    ASSERT_EQ(0, list.getStats().allocations);
+    ASSERT_EQ(0, array.getStats().live_bytes);
+    ASSERT_EQ(0, copy.getStats().copies);
+    ASSERT_EQ(0, AllocationStats::global().allocations);
+}
+
+#endif
+
+#endif
@@ -0,0 +1,107 @@
+/*
+ *  Test suite for the tracing ring buffer
+ *
+ *  All tests in this file should start with Trace*
+ */
+
+#ifndef TRACE_TESTS_H
+#define TRACE_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace testing;
+
+TEST(TraceBuffer, RecordsInOrder)
+{
+    TraceBuffer &trace = TraceBuffer::instance();
+    trace.clear();
+    int first = 0;
+    int second = 0;
+    trace.record(TraceEvent::COPY_ASSIGN, &first, 3);
+    trace.record(TraceEvent::DESTRUCT, &second, 0);
+
+    vector<TraceRecord> records = trace.snapshot();
+    ASSERT_EQ(2u, records.size());
+    ASSERT_EQ(0u, records[0].sequence);
+    ASSERT_TRUE(records[0].event == TraceEvent::COPY_ASSIGN);
+    ASSERT_EQ(&first, records[0].object);
+    ASSERT_EQ(3, records[0].size);
+    ASSERT_TRUE(records[1].event == TraceEvent::DESTRUCT);
+
+    stringstream out;
+    trace.dump(out);
+    ASSERT_THAT(out.str(), HasSubstr("copy assignment"));
+    ASSERT_THAT(out.str(), HasSubstr("destructor"));
+    trace.clear();
+}
+
+TEST(TraceBuffer, KeepsOnlyTheNewestEvents)
+{
+    TraceBuffer &trace = TraceBuffer::instance();
+    trace.clear();
+    const int total = TraceBuffer::CAPACITY + 10;
+    for (int i = 0; i < total; i++)
+        { trace.record(TraceEvent::MOVE_ASSIGN, nullptr, i); }
+
+    vector<TraceRecord> records = trace.snapshot();
+    ASSERT_EQ((size_t)TraceBuffer::CAPACITY, records.size());
+    ASSERT_EQ(10, records.front().size);
+    ASSERT_EQ(total - 1, records.back().size);
+    ASSERT_EQ((uint64_t)total, trace.getRecordedCount());
+    trace.clear();
+}
+
+TEST(TraceBuffer, ThreadsRecordWithoutLocks)
+{
+    TraceBuffer &trace = TraceBuffer::instance();
+    trace.clear();
+    vector<thread> threads;
+    for (int t = 0; t < 4; t++)
+    {
+        threads.push_back(thread([t, &trace]() {
+            for (int i = 0; i < 500; i++)
+                { trace.record(TraceEvent::COPY_CONSTRUCT, nullptr, t); }
+        }));
+    }
+    for (auto &worker : threads)
+        { worker.join(); }
+
+    vector<TraceRecord> records = trace.snapshot();
+    ASSERT_EQ(2000u, records.size());
+    int per_thread[4] = {};
+    for (const TraceRecord &record : records)
+        { per_thread[record.size]++; }
+    ASSERT_THAT(per_thread, Each(500));
+    trace.clear();
+}
+
+TEST(TraceLinkedList, BigFiveEvents)
+{
+    TraceBuffer &trace = TraceBuffer::instance();
+    trace.clear();
+    {
+        LinkedList<int> first{1, 2, 3};
+        LinkedList<int> second{ first };
+        second = first;
+        second = std::move(first);
+    }
+#ifdef CONTAINER_TRACE
+    vector<TraceRecord> records = trace.snapshot();
+    ASSERT_EQ(6u, records.size());
+    ASSERT_TRUE(records[0].event == TraceEvent::INITIALIZER_LIST_CONSTRUCT);
+    ASSERT_TRUE(records[1].event == TraceEvent::COPY_CONSTRUCT);
+    ASSERT_TRUE(records[2].event == TraceEvent::COPY_ASSIGN);
+    ASSERT_TRUE(records[3].event == TraceEvent::MOVE_ASSIGN);
+    ASSERT_EQ(3, records[3].size);
+    ASSERT_TRUE(records[4].event == TraceEvent::DESTRUCT);
+#else
+    ASSERT_EQ(0u, trace.getRecordedCount());    // Compiled out entirely
+#endif
+    trace.clear();
+}
+
+#endif
@@ -0,0 +1,129 @@
+/*
+ *  Test suite for UnrolledLinkedList
+ *
+ *  All tests in this file should start with Unrolled*
+ */
+
+#ifndef UNROLLED_TESTS_H
+#define UNROLLED_TESTS_H
+
+#include <gtest/gtest.h>    // Google testing harness
+#include <gmock/gmock.h>    // Google object mocking library
+#include <cstdlib>
+#include <string>
+#include <vector>
+
+using namespace testing;
+
+TEST(UnrolledLinkedList, AppendsFillWholeBlocks)
+{
+    UnrolledLinkedList<int> numbers;
+    int capacity = UnrolledLinkedList<int>::BLOCK_CAPACITY;
+    for (int i = 0; i < capacity * 3; i++)
+        { numbers.addElement(i); }
+    ASSERT_EQ(capacity * 3, numbers.getSize());
+    ASSERT_EQ(3, numbers.getBlockCount());
+    ASSERT_EQ(capacity * 2, numbers.getElementAt(capacity * 2));
+}
+
+TEST(UnrolledLinkedList, SplitsAndMergesBlocks)
+{
+    UnrolledLinkedList<int> numbers;
+    int capacity = UnrolledLinkedList<int>::BLOCK_CAPACITY;
+    for (int i = 0; i < capacity; i++)
+        { numbers.addElement(i); }
+    numbers.addElementAt(-1, 1);             // Full block splits
+    ASSERT_EQ(2, numbers.getBlockCount());
+    ASSERT_EQ(-1, numbers.getElementAt(1));
+    ASSERT_EQ(1, numbers.getElementAt(2));
+    numbers.removeElementAt(1);              // Halves fit together again
+    ASSERT_EQ(1, numbers.getBlockCount());
+    for (int i = 0; i < capacity; i++)
+        { ASSERT_EQ(i, numbers.getElementAt(i)); }
+}
+
+// Trimming every full block down to one item must not leave one block
+//  per item: sparse blocks merge with or borrow from their neighbours
+TEST(UnrolledLinkedList, RemovalsKeepBlocksHalfFull)
+{
+    UnrolledLinkedList<int> numbers;
+    int capacity = UnrolledLinkedList<int>::BLOCK_CAPACITY;
+    int half = capacity / 2;
+    for (int i = 0; i < capacity * 100; i++)
+        { numbers.addElement(i); }
+    ASSERT_EQ(100, numbers.getBlockCount());
+    for (int b = 0; b < 100; b++)
+    {
+        for (int i = 1; i < capacity; i++)
+            { numbers.removeElementAt(b + 1); }
+    }
+    ASSERT_EQ(100, numbers.getSize());
+    ASSERT_LE(numbers.getBlockCount(), 100 / half + 1);
+    for (int b = 0; b < 100; b++)
+        { ASSERT_EQ(b * capacity, numbers.getElementAt(b)); }
+
+    // Shrinking from the back borrows from or merges into the previous block
+    UnrolledLinkedList<string> words;
+    int word_capacity = UnrolledLinkedList<string>::BLOCK_CAPACITY;
+    int word_half = word_capacity / 2;
+    for (int i = 0; i < word_capacity * 10; i++)
+        { words.addElement(to_string(i)); }
+    srand(6);
+    while (words.getSize() > 3 * word_half)
+    {
+        words.removeElementAt(words.getSize() - 1 - rand() % 3);
+        ASSERT_LE(words.getBlockCount(), words.getSize() / word_half + 1);
+    }
+    ASSERT_EQ("0", words.getElementAt(0));
+}
+
+TEST(UnrolledLinkedList, MatchesVectorUnderRandomEdits)
+{
+    UnrolledLinkedList<string> list;
+    vector<string> model;
+    srand(223);
+    for (int step = 0; step < 5000; step++)
+    {
+        int size = (int)model.size();
+        if (size == 0 || rand() % 3 != 0)
+        {
+            int index = rand() % (size + 1);
+            string value = to_string(step);
+            list.addElementAt(value, index);
+            model.insert(model.begin() + index, value);
+        }
+        else
+        {
+            int index = rand() % size;
+            list.removeElementAt(index);
+            model.erase(model.begin() + index);
+        }
+    }
+    ASSERT_EQ((int)model.size(), list.getSize());
+    vector<string> result(list.begin(), list.end());
+    ASSERT_THAT(result, ElementsAreArray(model));
+    for (int i = 0; i < list.getSize(); i += 7)
+        { ASSERT_EQ(model[i], list.getElementAt(i)); }
+}
+
+TEST(UnrolledLinkedList, BigFive)
+{
+    UnrolledLinkedList<int> source{1, 2, 3, 4};
+    UnrolledLinkedList<int> copy{ source };
+    copy.setElementAt(20, 1);
+    ASSERT_EQ(2, source.getElementAt(1));
+
+    UnrolledLinkedList<int> moved{ std::move(source) };
+    ASSERT_EQ(0, source.getSize());
+    ASSERT_EQ(4, moved.getSize());
+
+    UnrolledLinkedList<int> assigned;
+    assigned = copy;
+    ASSERT_THAT(toVector(assigned), ElementsAre(1, 20, 3, 4));
+    assigned = std::move(moved);
+    ASSERT_THAT(toVector(assigned), ElementsAre(1, 2, 3, 4));
+    ASSERT_THROW(assigned.getElementAt(4), out_of_range);
+    ASSERT_THROW(assigned.removeElementAt(-1), out_of_range);
+}
+
+#endif